@@ -263,6 +263,10 @@ inline void configuration::fast_separator( PartitionConfig & partition_config )
 
 inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.filename_output                        = "";
+        partition_config.performance_report                     = "";
+        partition_config.memory_budget                          = 0;
+        partition_config.release_edge_ratings                   = false;
+        partition_config.release_coarse_levels                  = false;
         partition_config.seed                                   = 0;
         partition_config.fast                                   = false;
         partition_config.mode_node_separators                   = false;
@@ -279,6 +283,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.bipartition_tries                      = 9;
         partition_config.minipreps                              = 10;
         partition_config.enable_omp                             = false;
+        partition_config.num_threads                            = 1;
         partition_config.combine                                = false;
 #ifndef MODE_NODESEP
         partition_config.epsilon                                = 3; 
@@ -293,6 +298,7 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
 
         partition_config.time_limit 				= 0; 
         partition_config.mh_pool_size                           = 5;
+        partition_config.mh_pipeline_workers                    = 1;
         partition_config.mh_plain_repetitions                   = false;
         partition_config.no_unsuc_reps				= 10;
         partition_config.local_partitioning_repetitions 	= 1;
@@ -448,12 +454,17 @@ inline void configuration::standard( PartitionConfig & partition_config ) {
         partition_config.sep_full_boundary_ip          = false;
         partition_config.sep_edge_rating_during_ip     = SEPARATOR_MULTX;
 
+        //node ordering parameters
+        partition_config.dissection_rec_limit          = 120;
+
         partition_config.enable_mapping                    = false;
+        partition_config.topology_aware_refinement         = false;
         partition_config.ls_neighborhood                   = COMMUNICATIONGRAPH;
         partition_config.communication_neighborhood_dist   = 10;
         partition_config.construction_algorithm            = MAP_CONST_FASTHIERARCHY_TOPDOWN;
         partition_config.distance_construction_algorithm   = DIST_CONST_HIERARCHY;
         partition_config.search_space_s                    = 64;
+        partition_config.ls_swap_batch_size                = 1024;
         partition_config.preconfiguration_mapping          = PRE_CONFIG_MAPPING_ECO;
         partition_config.max_recursion_levels_construction = std::numeric_limits< int >::max();
 
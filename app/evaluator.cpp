@@ -52,11 +52,13 @@ int main(int argn, char **argv) {
         std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
         quality_metrics qm;
 
-        std::cout << "cut \t\t"         << qm.edge_cut(G)                 << std::endl;
-        std::cout << "no boundary vertices \t\t" << qm.boundary_nodes(G)           << std::endl;
-        std::cout << "balance \t"       << qm.balance(G)                  << std::endl;
-        std::cout << "balance based on edges \t"       << qm.balance_edges(G)                  << std::endl;
-        std::cout << "max comm vol \t"  << qm.max_communication_volume(G) << std::endl;
-        std::cout << "min comm vol \t"  << qm.min_communication_volume(G) << std::endl;
-        std::cout << "total comm vol \t"  << qm.total_communication_volume(G) << std::endl;
+        partition_metrics metrics = qm.all_metrics(G, partition_config.num_threads);
+
+        std::cout << "cut \t\t"         << metrics.edge_cut                   << std::endl;
+        std::cout << "no boundary vertices \t\t" << metrics.boundary_nodes  << std::endl;
+        std::cout << "balance \t"       << metrics.balance                    << std::endl;
+        std::cout << "balance based on edges \t"       << metrics.balance_edges   << std::endl;
+        std::cout << "max comm vol \t"  << metrics.max_communication_volume   << std::endl;
+        std::cout << "min comm vol \t"  << metrics.min_communication_volume   << std::endl;
+        std::cout << "total comm vol \t"  << metrics.total_communication_volume << std::endl;
 }
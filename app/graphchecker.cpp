@@ -7,27 +7,369 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <limits>
 #include <vector>
 #include <unordered_set>
+#include <omp.h>
 
 using namespace std;
 
+// a problem found by the fast checker, line is the line of the file (starting from 1)
+struct violation {
+        long line;
+        std::string message;
+
+        bool operator<(const violation & rhs) const {
+                return line < rhs.line;
+        }
+};
+
+// reads the next integer from [pos, end). returns false if the line has no more numbers,
+// invalid is set if the next token is not an integer
+static inline bool next_number(const char* & pos, const char* end, long & value, bool & invalid) {
+        while( pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r') ) pos++;
+        if( pos == end ) return false;
+
+        bool negative = false;
+        if( *pos == '-' || *pos == '+' ) {
+                negative = *pos == '-';
+                pos++;
+        }
+        if( pos == end || *pos < '0' || *pos > '9' ) {
+                invalid = true;
+                return false;
+        }
+
+        value = 0;
+        while( pos < end && *pos >= '0' && *pos <= '9' ) {
+                value = 10*value + (*pos - '0');
+                pos++;
+        }
+        if( pos < end && *pos != ' ' && *pos != '\t' && *pos != '\r' ) {
+                invalid = true;
+                return false;
+        }
+
+        if( negative ) value = -value;
+        return true;
+}
+
+// appends the violation to the list of the calling thread
+static inline void report(std::vector< std::vector< violation > > & violations, long line, const std::string & message) {
+        violation v;
+        v.line    = line;
+        v.message = message;
+        violations[omp_get_thread_num()].push_back(v);
+}
+
+// fast mode: the file is read at once and parsed in parallel. parallel edges are found by sorting the adjacency
+// of every node and the backward edges by a binary search in the sorted adjacency of the target, i.e. O(m log m)
+// instead of scanning the adjacency of the target for every edge. besides the file, memory is 4 bytes per arc
+// (plus 8 bytes if the file has edge weights) and O(n) line and node offsets.
+// all problems are reported, not only the first one
+static int fast_check(const std::string & filename, int num_threads) {
+        std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+        if (!in) {
+                std::cerr << "Error opening " << filename << std::endl;
+                return 1;
+        }
+
+        std::vector< char > buffer(in.tellg());
+        in.seekg(0);
+        in.read(buffer.data(), buffer.size());
+        if( buffer.empty() || buffer.back() != '\n' ) buffer.push_back('\n');
+
+        // split the file into lines, line i is [line_start[i], line_start[i+1] - 1).
+        // the buffer is split into a fixed number of chunks, i.e. the result does not depend on the size of the team
+        std::vector< long > line_start;
+        {
+                const long size   = buffer.size();
+                const int  chunks = num_threads;
+                std::vector< long > chunk_offset(chunks + 1, 0);
+
+                #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+                for( int c = 0; c < chunks; c++) {
+                        for( long i = size * c / chunks; i < size * (c + 1) / chunks; i++) {
+                                if( buffer[i] == '\n' ) chunk_offset[c + 1]++;
+                        }
+                }
+
+                for( int c = 0; c < chunks; c++) chunk_offset[c + 1] += chunk_offset[c];
+                line_start.resize(chunk_offset[chunks] + 1);
+                line_start[0] = 0;
+
+                #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+                for( int c = 0; c < chunks; c++) {
+                        long pos = chunk_offset[c] + 1;
+                        for( long i = size * c / chunks; i < size * (c + 1) / chunks; i++) {
+                                if( buffer[i] == '\n' ) line_start[pos++] = i + 1;
+                        }
+                }
+        }
+        const long number_of_lines = line_start.size() - 1;
+
+        // header
+        long header = 0;
+        while( header < number_of_lines && buffer[line_start[header]] == '%' ) header++;
+        if( header == number_of_lines ) {
+                std::cout <<  "The file does not contain a header line."  << std::endl;
+                std::cout <<  "*******************************************************************************"  << std::endl;
+                return 0;
+        }
+
+        long nmbNodes = 0;
+        long nmbEdges = 0;
+        long ew       = 0;
+        {
+                const char* pos = &buffer[line_start[header]];
+                const char* end = &buffer[line_start[header + 1] - 1];
+                bool invalid    = false;
+                next_number(pos, end, nmbNodes, invalid);
+                next_number(pos, end, nmbEdges, invalid);
+                next_number(pos, end, ew, invalid);
+        }
+        if( nmbNodes < 0 || nmbNodes >= (long)std::numeric_limits<unsigned int>::max() ) {
+                std::cout <<  "The number of nodes " <<  nmbNodes << " specified in line " << header+1 << " is not supported."  << std::endl;
+                std::cout <<  "*******************************************************************************"  << std::endl;
+                return 0;
+        }
+
+        bool node_weights = ew == 10 || ew == 11;
+        bool edge_weights = ew == 1  || ew == 11;
+
+        // every line after the header that is not a comment belongs to a node
+        std::vector< long > node_line;
+        node_line.reserve(nmbNodes);
+        for( long line = header + 1; line < number_of_lines; line++) {
+                if( buffer[line_start[line]] != '%' ) node_line.push_back(line);
+        }
+
+        if( (long)node_line.size() != nmbNodes ) {
+                std::cout <<  "The number of nodes specified in the beginning of the file "
+                          <<  "does not match the number of nodes that are in the file."  << std::endl;
+                std::cout <<  "You specified " <<  nmbNodes <<  " but there are " <<  node_line.size()  << std::endl;
+                std::cout <<  "*******************************************************************************"  << std::endl;
+                return 0;
+        }
+
+        std::vector< std::vector< violation > > violations(num_threads);
+        std::vector< long > node_starts(nmbNodes + 1, 0);
+        long total_nodeweight = 0;
+
+        // first pass: degrees, node weights and the amount of numbers in every line
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024) reduction(+:total_nodeweight)
+        for( long node = 0; node < nmbNodes; node++) {
+                long line       = node_line[node];
+                const char* pos = &buffer[line_start[line]];
+                const char* end = &buffer[line_start[line + 1] - 1];
+
+                bool invalid  = false;
+                long value    = 0;
+                long numbers  = 0;
+                while( next_number(pos, end, value, invalid) ) {
+                        if( numbers == 0 && node_weights ) {
+                                if( value < 0 ) report(violations, line + 1, "The node " + std::to_string(node+1) + " has weight < 0.");
+                                total_nodeweight += value;
+                        }
+                        numbers++;
+                }
+                if( invalid ) {
+                        report(violations, line + 1, "The line contains a token that is not an integer.");
+                }
+
+                long entries = numbers - (node_weights ? 1 : 0);
+                if( entries < 0 || (edge_weights && entries % 2 != 0) ) {
+                        report(violations, line + 1, "There is not the right amount of numbers in the line, "
+                                                     "a node weight or an edge weight is missing.");
+                        entries = std::max(0L, entries);
+                }
+                node_starts[node + 1] = edge_weights ? entries / 2 : entries;
+        }
+
+        if( total_nodeweight > (long)std::numeric_limits<unsigned int>::max() ) {
+                report(violations, header + 1, "The sum of the node weights exeeds 32 bits. Currently not supported.");
+        }
+
+        for( long node = 0; node < nmbNodes; node++) {
+                node_starts[node + 1] += node_starts[node];
+        }
+        const long number_of_edges = node_starts[nmbNodes];
+        if( number_of_edges != 2*nmbEdges ) {
+                report(violations, header + 1, "The number of edges specified in the beginning of the file does not match "
+                                               "the number of edges that are in the file. You specified " + std::to_string(2*nmbEdges) +
+                                               " but there are " + std::to_string(number_of_edges) + ".");
+        }
+
+        // second pass: adjacency, targets that are out of range are stored as INVALID_TARGET and ignored afterwards.
+        // the edge weights are only stored if the file has edge weights
+        const unsigned int INVALID_TARGET = std::numeric_limits<unsigned int>::max();
+        std::vector< unsigned int > adjacent_nodes(number_of_edges);
+        std::vector< long > graph_edgeweights(edge_weights ? number_of_edges : 0);
+        long total_edgeweight = 0;
+
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024) reduction(+:total_edgeweight)
+        for( long node = 0; node < nmbNodes; node++) {
+                long line       = node_line[node];
+                const char* pos = &buffer[line_start[line]];
+                const char* end = &buffer[line_start[line + 1] - 1];
+
+                bool invalid = false;
+                long value   = 0;
+                if( node_weights ) next_number(pos, end, value, invalid);
+
+                for( long e = node_starts[node]; e < node_starts[node + 1]; e++) {
+                        long target = 0;
+                        next_number(pos, end, target, invalid);
+                        if( target > nmbNodes || target <= 0 ) {
+                                report(violations, line + 1, "Node " + std::to_string(node+1) + " has an edge to a node greater than the number "
+                                                             "of nodes specified in the file or smaller or equal to zero, i.e. it has target " +
+                                                             std::to_string(target) + ".");
+                                adjacent_nodes[e] = INVALID_TARGET;
+                        } else {
+                                adjacent_nodes[e] = target - 1;
+                        }
+
+                        if( edge_weights ) {
+                                long edge_weight = 1;
+                                next_number(pos, end, edge_weight, invalid);
+                                if( edge_weight <= 0 ) {
+                                        report(violations, line + 1, "The edge starting from node " + std::to_string(node+1) + " and ending in node " +
+                                                                     std::to_string(target) + " has weight <= 0.");
+                                }
+                                graph_edgeweights[e] = edge_weight;
+                                total_edgeweight    += edge_weight;
+                        }
+                }
+        }
+
+        if( total_edgeweight > (long)std::numeric_limits<unsigned int>::max() ) {
+                report(violations, header + 1, "The sum of the edge weights exeeds 32 bits. Currently not supported.");
+        }
+
+        // parallel edges and self-loops, the adjacency of every node is sorted by target in place
+        #pragma omp parallel num_threads(num_threads)
+        {
+                std::vector< std::pair< unsigned int, long > > adjacency;
+
+                #pragma omp for schedule(dynamic, 1024)
+                for( long node = 0; node < nmbNodes; node++) {
+                        long line = node_line[node];
+                        long first = node_starts[node];
+                        long last  = node_starts[node + 1];
+                        if( edge_weights ) {
+                                adjacency.clear();
+                                for( long e = first; e < last; e++) {
+                                        adjacency.push_back(std::make_pair(adjacent_nodes[e], graph_edgeweights[e]));
+                                }
+                                std::sort(adjacency.begin(), adjacency.end());
+                                for( long e = first; e < last; e++) {
+                                        adjacent_nodes[e]    = adjacency[e - first].first;
+                                        graph_edgeweights[e] = adjacency[e - first].second;
+                                }
+                        } else {
+                                std::sort(adjacent_nodes.begin() + first, adjacent_nodes.begin() + last);
+                        }
+
+                        for( long e = first; e < last; e++) {
+                                unsigned int target = adjacent_nodes[e];
+                                if( target == INVALID_TARGET ) continue;
+
+                                if( e > first && adjacent_nodes[e-1] == target ) {
+                                        report(violations, line + 1, "The file contains parallel edges, " + std::to_string(target+1) + " is listed twice.");
+                                }
+                                if( target == node ) {
+                                        report(violations, line + 1, "The file contains a graph with self-loops, the target " + std::to_string(target+1) + " is listed.");
+                                }
+                        }
+                }
+        }
+
+        // backward edges: the reverse of every edge (node,target) is searched in the sorted adjacency of target, 
+        // i.e. O(m log m) without any additional memory per edge. missing reverse edges are reported by the node 
+        // that has the edge, different weights by the smaller endpoint
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024)
+        for( long node = 0; node < nmbNodes; node++) {
+                for( long e = node_starts[node]; e < node_starts[node + 1]; e++) {
+                        unsigned int target = adjacent_nodes[e];
+                        if( target == INVALID_TARGET || target == node ) continue;
+
+                        std::vector< unsigned int >::iterator begin = adjacent_nodes.begin() + node_starts[target];
+                        std::vector< unsigned int >::iterator end   = adjacent_nodes.begin() + node_starts[target + 1];
+                        std::vector< unsigned int >::iterator it    = std::lower_bound(begin, end, (unsigned int)node);
+                        if( it == end || *it != node ) {
+                                report(violations, node_line[node] + 1, "The file does not contain all forward and backward edges. Node " +
+                                                                        std::to_string(node+1) + " does contain an arc to node " + std::to_string(target+1) +
+                                                                        " but there is no edge (" + std::to_string(target+1) + "," + std::to_string(node+1) +
+                                                                        ") in the file. Please insert this edge in line " +
+                                                                        std::to_string(node_line[target]+1) + " of the file.");
+                                continue;
+                        }
+
+                        long e_backward = it - adjacent_nodes.begin();
+                        if( edge_weights && node < target && graph_edgeweights[e] != graph_edgeweights[e_backward] ) {
+                                report(violations, node_line[node] + 1, "The weights of the forward edges must be equal to the weight of the backward edges. Node " +
+                                                                        std::to_string(node+1) + " does contain an arc to node " + std::to_string(target+1) +
+                                                                        " with weight " + std::to_string(graph_edgeweights[e]) +
+                                                                        " but the weight of the backward edge in line " + std::to_string(node_line[target]+1) +
+                                                                        " is " + std::to_string(graph_edgeweights[e_backward]) + ".");
+                        }
+                }
+        }
+
+        std::vector< violation > all_violations;
+        for( int t = 0; t < num_threads; t++) {
+                all_violations.insert(all_violations.end(), violations[t].begin(), violations[t].end());
+        }
+        std::stable_sort(all_violations.begin(), all_violations.end());
+
+        if( all_violations.empty() ) {
+                std::cout <<  "The graph format seems correct."  << std::endl;
+        } else {
+                for( unsigned i = 0; i < all_violations.size(); i++) {
+                        std::cout <<  "Line " << all_violations[i].line << ": " << all_violations[i].message << std::endl;
+                }
+                std::cout <<  "Found " <<  all_violations.size() << " problems."  << std::endl;
+        }
+        std::cout <<  "*******************************************************************************"  << std::endl;
+
+        return 0;
+}
+
 // this program implements the functions to check the metis graph 
 // format
 int main(int argn, char **argv)
 {
 
-        if( argn != 2 ) {
-                std::cout <<  "Usage: graphchecker FILE"  << std::endl;
+        std::string filename;
+        bool fast        = false;
+        int  num_threads = 0;
+        for( int i = 1; i < argn; i++) {
+                std::string arg(argv[i]);
+                if( arg == "--fast" ) {
+                        fast = true;
+                } else if( arg.compare(0, 14, "--num_threads=") == 0 ) {
+                        num_threads = atoi(arg.c_str() + 14);
+                } else if( filename.empty() ) {
+                        filename = arg;
+                } else {
+                        filename.clear();
+                        break;
+                }
+        }
+
+        if( filename.empty() ) {
+                std::cout <<  "Usage: graphchecker FILE [--fast] [--num_threads=<int>]"  << std::endl;
+                std::cout <<  "  --fast              parallel checker that reports all problems of the file"  << std::endl;
+                std::cout <<  "  --num_threads=<int> number of threads of the fast checker (Default: all)"  << std::endl;
                 exit(0);
         }
 
         std::string line;
-        std::string filename(argv[1]);
 
         // open file for reading
         std::ifstream in(filename.c_str());
@@ -41,6 +383,11 @@ int main(int argn, char **argv)
         std::cout <<  "Output will be given using the IDs from file, i.e. the IDs are starting from 1."  << std::endl;
         std::cout <<  "*******************************************************************************"  << std::endl;
 
+        if( fast ) {
+                in.close();
+                return fast_check(filename, num_threads > 0 ? num_threads : omp_get_max_threads());
+        }
+
         std::getline(in,line);
         //skip comments
         while( line[0] == '%' ) {
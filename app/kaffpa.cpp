@@ -20,10 +20,12 @@
 #include "graph_io.h"
 #include "macros_assertions.h"
 #include "mapping/mapping_algorithms.h"
+#include "memory_budget.h"
 #include "parse_parameters.h"
 #include "partition/graph_partitioner.h"
 #include "partition/partition_config.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
+#include "phase_timer.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
@@ -57,14 +59,22 @@ int main(int argn, char **argv) {
         partition_config.LogDump(stdout);
         graph_access G;     
 
+        phase_timer* ptimer = phase_timer::getInstance();
+        if(!partition_config.performance_report.empty()) {
+                ptimer->enable("kaffpa");
+        }
+
         timer t;
+        ptimer->begin("io");
         graph_io::readGraphWeighted(G, graph_filename);
+        ptimer->end();
         std::cout << "io time: " << t.elapsed()  << std::endl;
 
         G.set_partition_count(partition_config.k); 
 
         balance_configuration bc;
         bc.configurate_balance( partition_config, G);
+        memory_budget::apply( partition_config, G);
 
         srand(partition_config.seed);
         random_functions::setSeed(partition_config.seed);
@@ -76,6 +86,9 @@ int main(int argn, char **argv) {
         quality_metrics qm;
 
         std::cout <<  "performing partitioning!"  << std::endl;
+        ptimer->begin("partitioning");
+        ptimer->set_value("nodes", G.number_of_nodes());
+        ptimer->set_value("edges", G.number_of_edges());
         if(partition_config.time_limit == 0) {
                 partitioner.perform_partitioning(partition_config, G);
         } else {
@@ -108,12 +121,15 @@ int main(int argn, char **argv) {
                 cycle_refinement cr;
                 cr.perform_refinement(partition_config, G, boundary);
         }
+        if(ptimer->enabled()) ptimer->set_value("cut", qm.edge_cut(G));
+        ptimer->end();
         ofs.close();
         std::cout.rdbuf(backup);
         std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
 
         int qap = 0;
         if(partition_config.enable_mapping) {
+                phase_scope mapping_phase("mapping");
                 std::cout <<  "performing mapping!"  << std::endl;
                 //check if k is a power of 2 
                 bool power_of_two = (partition_config.k & (partition_config.k-1)) == 0;
@@ -188,4 +204,12 @@ int main(int argn, char **argv) {
 
         graph_io::writePartition(G, filename.str());
 
+        if(!partition_config.performance_report.empty()) {
+                if(ptimer->write_json(partition_config.performance_report)) {
+                        std::cout <<  "performance report written to " << partition_config.performance_report  << std::endl;
+                } else {
+                        std::cerr <<  "Error opening " << partition_config.performance_report  << std::endl;
+                }
+        }
+
 }
@@ -19,7 +19,9 @@
 #include "data_structure/graph_access.h"
 #include "graph_io.h"
 #include "macros_assertions.h"
+#include "memory_budget.h"
 #include "parallel_mh/parallel_mh_async.h"
+#include "parallel_mh/parallel_mh_threaded.h"
 #include "parse_parameters.h"
 #include "partition/graph_partitioner.h"
 #include "partition/partition_config.h"
@@ -29,7 +31,9 @@
 
 int main(int argn, char **argv) {
 
-        MPI_Init(&argn, &argv);    /* starts MPI */
+        // islands and offspring workers may be threads, but only the main thread calls MPI
+        int provided;
+        MPI_Init_thread(&argn, &argv, MPI_THREAD_FUNNELED, &provided);    /* starts MPI */
 
         PartitionConfig partition_config;
         std::string graph_filename;
@@ -46,6 +50,12 @@ int main(int argn, char **argv) {
                 return 0;
         }
 
+        if( provided < MPI_THREAD_FUNNELED && (partition_config.num_threads > 1 || partition_config.mh_pipeline_workers > 1) ) {
+                std::cout <<  "MPI library does not support threads, using one thread and one offspring worker"  << std::endl;
+                partition_config.num_threads         = 1;
+                partition_config.mh_pipeline_workers = 1;
+        }
+
         partition_config.LogDump(stdout);
         partition_config.graph_filename = graph_filename.substr( graph_filename.find_last_of( '/' ) +1 );
 
@@ -79,17 +89,26 @@ int main(int argn, char **argv) {
                 } endfor
         }
 
-        t.restart();
-
-        parallel_mh_async mh;
-        mh.perform_partitioning(partition_config, G);
-
-        
         int rank, size;
         MPI_Comm communicator = MPI_COMM_WORLD; 
         MPI_Comm_rank( communicator, &rank);
         MPI_Comm_size( communicator, &size);
 
+        // islands that are threads share the memory of the process
+        unsigned concurrent_runs = partition_config.num_threads > 1 && size == 1 ? partition_config.num_threads : 1;
+        memory_budget::apply( partition_config, G, concurrent_runs);
+
+        t.restart();
+
+        if( partition_config.num_threads > 1 && size == 1 ) {
+                // islands are threads that share the process
+                parallel_mh_threaded mh;
+                mh.perform_partitioning(partition_config, G);
+        } else {
+                parallel_mh_async mh;
+                mh.perform_partitioning(partition_config, G);
+        }
+
         if( rank == ROOT ) {
                 std::cout <<  "time spent for partitioning " << t.elapsed()  << std::endl;
                 std::cout <<  "time spent in neg. cycle detection " <<  cycle_search::total_time  << std::endl;
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * node_ordering.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <argtable3.h>
+#include <fstream>
+#include <iostream>
+#include <math.h>
+#include <regex.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h> 
+
+#include "data_structure/graph_access.h"
+#include "graph_io.h"
+#include "macros_assertions.h"
+#include "node_ordering/nested_dissection.h"
+#include "parse_parameters.h"
+#include "partition/partition_config.h"
+#include "partition/uncoarsening/separator/area_bfs.h"
+#include "random_functions.h"
+#include "timer.h"
+
+int main(int argn, char **argv) {
+
+        PartitionConfig partition_config;
+        std::string graph_filename;
+
+        bool is_graph_weighted = false;
+        bool suppress_output   = false;
+        bool recursive         = false;
+       
+        int ret_code = parse_parameters(argn, argv, 
+                                        partition_config, 
+                                        graph_filename, 
+                                        is_graph_weighted, 
+                                        suppress_output, recursive); 
+
+        if(ret_code) {
+                return 0;
+        }
+
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream ofs;
+        ofs.open("/dev/null");
+        if(suppress_output) {
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
+
+        partition_config.LogDump(stdout);
+        graph_access G;     
+
+        timer t;
+        graph_io::readGraphWeighted(G, graph_filename);
+        std::cout << "io time: " << t.elapsed()  << std::endl;
+
+        partition_config.k = 2;
+        G.set_partition_count(partition_config.k); 
+ 
+        srand(partition_config.seed);
+        random_functions::setSeed(partition_config.seed);
+
+        std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
+        // ***************************** compute ordering ********************************************       
+        t.restart();
+        area_bfs::m_deepth.resize(G.number_of_nodes());
+        forall_nodes(G, node) {
+                area_bfs::m_deepth[node] = 0;
+        } endfor
+
+        // the logs of the separator computations of concurrent tasks would interleave
+        std::streambuf* log_backup = std::cout.rdbuf();
+        std::cout.rdbuf(ofs.rdbuf()); 
+
+        std::vector< NodeID > ordering;
+        nested_dissection nd;
+        nd.perform_nested_dissection(partition_config, G, ordering);
+
+        std::cout.rdbuf(log_backup);
+
+        // ******************************* done ordering *********************************************       
+        std::cout <<  "time spent to compute node ordering " << t.elapsed()  << std::endl;
+
+        std::stringstream filename;
+        if(!partition_config.filename_output.compare("")) {
+                filename << "tmpnodeordering";
+        } else {
+                filename << partition_config.filename_output;
+        }
+
+        graph_io::writeVector(ordering, filename.str());
+
+        ofs.close();
+        std::cout.rdbuf(backup);
+}
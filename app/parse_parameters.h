@@ -40,15 +40,24 @@ int parse_parameters(int argn, char **argv,
         struct arg_lit *disable_refined_bubbling             = arg_lit0(NULL, "disable_refined_bubbling", "Disables refinement during initial partitioning using bubbling (Default: enabled).");
         struct arg_lit *enable_convergence                   = arg_lit0(NULL, "enable_convergence", "Enables convergence mode, i.e. every step is running until no change.(Default: disabled).");
         struct arg_lit *enable_omp                           = arg_lit0(NULL, "enable_omp", "Enable parallel omp.");
+#if defined MODE_NODEORDERING || defined MODE_KAFFPAE
+        struct arg_int *num_threads                          = arg_int0(NULL, "num_threads", NULL, "Number of threads to use. With more than one thread the result is not reproducible for a fixed seed. (Default: 1)");
+#else
+        struct arg_int *num_threads                          = arg_int0(NULL, "num_threads", NULL, "Number of threads to use. (Default: 1)");
+#endif
+        struct arg_int *dissection_rec_limit                 = arg_int0(NULL, "dissection_rec_limit", NULL, "Subgraphs with at most this many nodes are ordered using minimum degree. (Default: 120)");
         struct arg_lit *wcycle_no_new_initial_partitioning   = arg_lit0(NULL, "wcycle_no_new_initial_partitioning", "Using this option, the graph is initially partitioned only the first time we are at the deepest level.");
         struct arg_str *filename                             = arg_strn(NULL, NULL, "FILE", 1, 1, "Path to graph file to partition.");
         struct arg_str *filename_output                      = arg_str0(NULL, "output_filename", NULL, "Specify the name of the output file (that contains the partition).");
+        struct arg_str *performance_report                   = arg_str0(NULL, "performance_report", NULL, "Write the time, level sizes, cut improvements and peak memory of the phases of the partitioner to this file (json).");
+        struct arg_dbl *memory_budget                        = arg_dbl0(NULL, "memory_budget", NULL, "Memory budget in MB. If the projected peak memory exceeds it, edge ratings and coarse levels are freed early and flow regions are shrunk. Default: no budget.");
         struct arg_int *user_seed                            = arg_int0(NULL, "seed", NULL, "Seed to use for the PRNG.");
         struct arg_int *k                                    = arg_int1(NULL, "k", NULL, "Number of blocks to partition the graph.");
         struct arg_rex *edge_rating                          = arg_rex0(NULL, "edge_rating", "^(weight|realweight|expansionstar|expansionstar2|expansionstar2deg|punch|expansionstar2algdist|expansionstar2algdist2|algdist|algdist2|sepmultx|sepaddx|sepmax|seplog|r1|r2|r3|r4|r5|r6|r7|r8)$", "RATING", REG_EXTENDED, "Edge rating to use. One of {weight, expansionstar, expansionstar2, punch, sepmultx, sepaddx, sepmax, seplog, " " expansionstar2deg}. Default: weight"  );
         struct arg_rex *refinement_type                      = arg_rex0(NULL, "refinement_type", "^(fm|fm_flow|flow)$", "TYPE", REG_EXTENDED, "Refinementvariant to use. One of {fm, fm_flow, flow}. Default: fm"  );
         struct arg_rex *matching_type                        = arg_rex0(NULL, "matching", "^(random|hem|shem|regions|gpa|randomgpa|localmax)$", "TYPE", REG_EXTENDED, "Type of matchings to use during coarsening. One of {random, hem," " shem, regions, gpa, randomgpa, localmax}."  );
         struct arg_int *mh_pool_size                         = arg_int0(NULL, "mh_pool_size", NULL, "MetaHeuristic Pool Size.");
+        struct arg_int *mh_pipeline_workers                  = arg_int0(NULL, "mh_pipeline_workers", NULL, "Number of threads that compute offspring of an island concurrently. (Default: 1)");
         struct arg_lit *mh_plain_repetitions                 = arg_lit0(NULL, "mh_plain_repetitions", "");
         struct arg_lit *mh_penalty_for_unconnected           = arg_lit0(NULL, "mh_penalty_for_unconnected", "Add a penalty on the objective function if the computed partition contains blocks that are not connected.");
         struct arg_lit *mh_disable_nc_combine                = arg_lit0(NULL, "mh_disable_nc_combine", "");
@@ -158,6 +167,7 @@ int parse_parameters(int argn, char **argv,
         struct arg_str *hierarchy_parameter_string           = arg_str0(NULL, "hierarchy_parameter_string", NULL, "Specify as 4:8:8 for 4 cores per PE, 8 PEs per rack, ... and so forth.");
         struct arg_str *distance_parameter_string            = arg_str0(NULL, "distance_parameter_string", NULL, "Specify as 1:10:100 if cores on the same chip have distance 1, PEs in the same rack have distance 10, ... and so forth.");
         struct arg_lit *online_distances                     = arg_lit0(NULL, "online_distances", "Do not store processor distances in a matrix, but do recomputation. (Default: disabled)");
+        struct arg_lit *topology_aware_refinement            = arg_lit0(NULL, "topology_aware_refinement", "Let the k-way refinement minimize the communication cost on the processor hierarchy during uncoarsening (requires --enable_mapping). (Default: disabled)");
 
         struct arg_end *end                                  = arg_end(100);
 
@@ -180,12 +190,12 @@ int parse_parameters(int argn, char **argv,
                 enable_convergence, compute_vertex_separator, suppress_output, 
                 input_partition, preconfiguration, only_first_level, disable_max_vertex_weight_constraint, 
                 recursive_bipartitioning, use_bucket_queues, time_limit, unsuccessful_reps, local_partitioning_repetitions, 
-                mh_pool_size, mh_plain_repetitions, mh_disable_nc_combine, mh_disable_cross_combine, mh_enable_tournament_selection,       
+                mh_pool_size, mh_pipeline_workers, mh_plain_repetitions, mh_disable_nc_combine, mh_disable_cross_combine, mh_enable_tournament_selection,       
                 mh_disable_combine, mh_enable_quickstart, mh_disable_diversify_islands, mh_flip_coin, mh_initial_population_fraction, 
 		mh_print_log,mh_sequential_mode, mh_optimize_communication_volume, mh_enable_tabu_search,
                 mh_disable_diversify, mh_diversify_best, mh_cross_combine_original_k, disable_balance_singletons, initial_partition_optimize_fm_limits,
                 initial_partition_optimize_multitry_fm_alpha, initial_partition_optimize_multitry_rounds,
-                enable_omp, 
+                enable_omp, num_threads,
                 amg_iterations,
                 kaba_neg_cycle_algorithm, kabaE_internal_bal, kaba_internal_no_aug_steps_aug, 
                 kaba_packing_iterations, kaba_flip_packings, kaba_lsearch_p, kaffpa_perfectly_balanced_refinement, 
@@ -201,16 +211,28 @@ int parse_parameters(int argn, char **argv,
                 hierarchy_parameter_string, 
                 distance_parameter_string,
                 online_distances,
+                topology_aware_refinement,
+                num_threads,
+                matching_type,
                 filename_output, 
+                performance_report,
+                memory_budget,
 #elif defined MODE_EVALUATOR
                 k,   
                 preconfiguration, 
                 input_partition,
+                num_threads,
+#elif defined MODE_NODEORDERING
+                preconfiguration, 
+                filename_output, 
+                dissection_rec_limit,
+                num_threads,
 #elif defined MODE_NODESEP
                 //k,
                 imbalance,  
                 preconfiguration, 
                 filename_output, 
+                num_threads,
                 //time_limit, 
                 //edge_rating,
                 //max_flow_improv_steps,
@@ -250,6 +272,9 @@ int parse_parameters(int argn, char **argv,
 		balance_edges,
                 input_partition,
                 filename_output, 
+                num_threads,
+                mh_pipeline_workers,
+                memory_budget,
 #elif defined MODE_LABELPROPAGATION
                 cluster_upperbound,
                 label_propagation_iterations,
@@ -388,10 +413,28 @@ int parse_parameters(int argn, char **argv,
                 partition_config.distance_construction_algorithm = DIST_CONST_HIERARCHY_ONLINE;
         }
 
+        if(topology_aware_refinement->count > 0) {
+                if(!partition_config.enable_mapping) {
+                        std::cout <<  "Topology aware refinement requires the --enable_mapping option."  << std::endl;
+                        exit(0);
+                }
+                // blocks are already placed on their PEs, the mapping only improves this placement
+                partition_config.topology_aware_refinement = true;
+                partition_config.construction_algorithm    = MAP_CONST_IDENTITY;
+        }
+
         if(filename_output->count > 0) {
                 partition_config.filename_output = filename_output->sval[0];
         }
 
+        if(performance_report->count > 0) {
+                partition_config.performance_report = performance_report->sval[0];
+        }
+
+        if(memory_budget->count > 0) {
+                partition_config.memory_budget = std::max(0.0, memory_budget->dval[0]);
+        }
+
         if(initial_partition_optimize->count > 0) {
                 partition_config.initial_partition_optimize = true;
         }
@@ -604,6 +647,10 @@ int parse_parameters(int argn, char **argv,
                 partition_config.mh_pool_size = mh_pool_size->ival[0];
         }
 
+        if(mh_pipeline_workers->count > 0) {
+                partition_config.mh_pipeline_workers = std::max(1, mh_pipeline_workers->ival[0]);
+        }
+
         if(mh_penalty_for_unconnected->count > 0) {
                 partition_config.mh_penalty_for_unconnected = true;
         }
@@ -650,6 +697,11 @@ int parse_parameters(int argn, char **argv,
 
         if(mh_cross_combine_original_k->count > 0) {
                 partition_config.mh_cross_combine_original_k = true;
+                if(partition_config.mh_pipeline_workers > 1) {
+                        // concurrent offspring workers can not take part in the broadcast of k
+                        std::cout <<  "--mh_cross_combine_original_k requires a single offspring worker, using --mh_pipeline_workers=1."  << std::endl;
+                        partition_config.mh_pipeline_workers = 1;
+                }
         }
 
         if(mh_sequential_mode->count > 0) {
@@ -660,6 +712,14 @@ int parse_parameters(int argn, char **argv,
                 partition_config.enable_omp = true;
         }
 
+        if(num_threads->count > 0) {
+                partition_config.num_threads = std::max(1, num_threads->ival[0]);
+        }
+
+        if(dissection_rec_limit->count > 0) {
+                partition_config.dissection_rec_limit = dissection_rec_limit->ival[0];
+        }
+
         if(compute_vertex_separator->count > 0) {
                 partition_config.compute_vertex_separator = true;
         }
@@ -993,6 +1053,8 @@ int parse_parameters(int argn, char **argv,
                         partition_config.matching_type = MATCHING_GPA;
                 } else if (strcmp("randomgpa", matching_type->sval[0]) == 0) {
                         partition_config.matching_type = MATCHING_RANDOM_GPA;
+                } else if (strcmp("localmax", matching_type->sval[0]) == 0) {
+                        partition_config.matching_type = MATCHING_LOCAL_MAX;
                 } else {
                         fprintf(stderr, "Invalid matching variant: \"%s\"\n", matching_type->sval[0]);
                         exit(0);
@@ -15,6 +15,10 @@
 
 struct SpacConfig {
     EdgeWeight infinity;
+    bool streaming;
+    bool implicit_split_graph;
+    double hdrf_lambda;
+    std::string vertex_prior_filename;
 };
 
 int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_config, SpacConfig &spac_config,
@@ -30,10 +34,15 @@ int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_conf
     struct arg_rex *preconfiguration = arg_rex1(NULL, "preconfiguration", "^(strong$|eco$|fast$|fastsocial|ecosocial|strongsocial)$", "VARIANT", REG_EXTENDED, "Use a preconfiguration. (Default: eco) [strong|eco|fast|fastsocial|ecosocial|strongsocial]." );
     struct arg_int *infinity = arg_int0(NULL, "infinity", NULL, "Infinity edge weight. Default: 1000");
     struct arg_int *imbalance = arg_int0(NULL, "imbalance", NULL, "Desired imbalance. Default: 3%");
+    struct arg_lit *streaming = arg_lit0(NULL, "streaming", "Stream the edges of the graph file (HDRF) instead of partitioning the split graph. Does not load the graph, but buffers one decision per undirected edge, i.e. memory is linear in the number of edges.");
+    struct arg_lit *implicit_split_graph = arg_lit0(NULL, "implicit_split_graph", "Compute the first coarsening level of the split graph on an implicit view and partition the contracted graph. The split graph is not materialized.");
+    struct arg_dbl *hdrf_lambda = arg_dbl0(NULL, "hdrf_lambda", NULL, "Weight of the balance term in streaming mode. Default: 1.0");
+    struct arg_str *vertex_prior = arg_str0(NULL, "vertex_partition_prior", NULL, "Streaming mode: file with a (coarse) vertex partition, edges are preferably assigned to the blocks of their endpoints.");
     struct arg_end *end = arg_end(100);
 
     void *argtable[] = {
-            help, filename, k, seed, preconfiguration, infinity, filename_output, imbalance, end
+            help, filename, k, seed, preconfiguration, infinity, filename_output, imbalance,
+            streaming, implicit_split_graph, hdrf_lambda, vertex_prior, end
     };
 
     // Parse arguments.
@@ -104,6 +113,19 @@ int parse_spac_parameters(int argn, char **argv, PartitionConfig &partition_conf
         partition_config.imbalance = imbalance->ival[0];
     }
 
+    spac_config.streaming = streaming->count > 0;
+    spac_config.implicit_split_graph = implicit_split_graph->count > 0;
+
+    if (hdrf_lambda->count > 0) {
+        spac_config.hdrf_lambda = hdrf_lambda->dval[0];
+    } else {
+        spac_config.hdrf_lambda = 1.0;
+    }
+
+    if (vertex_prior->count > 0) {
+        spac_config.vertex_prior_filename = vertex_prior->sval[0];
+    }
+
     return 0;
 }
 
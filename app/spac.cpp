@@ -22,9 +22,13 @@
 #include "tools/timer.h"
 #include "io/graph_io.h"
 #include "spac/spac.h"
+#include "spac/streaming_edge_partitioner.h"
 #include "tools/quality_metrics.h"
 
 static void execute_kahip(graph_access &G, PartitionConfig &config);
+static int execute_streaming(const std::string &graph_filename, PartitionConfig &config, SpacConfig &spac_config);
+static void write_edge_partition(std::vector<PartitionID> &edge_partition, PartitionConfig &config);
+static std::string edge_partition_filename(PartitionConfig &config);
 
 int main(int argn, char **argv) {
     PartitionConfig partition_config;
@@ -40,6 +44,10 @@ int main(int argn, char **argv) {
               //<< "seed: " << partition_config.seed << "\n"
               //<< "k: " << partition_config.k << std::endl;
 
+    if (spac_config.streaming) {
+        return execute_streaming(graph_filename, partition_config, spac_config);
+    }
+
     timer t;
 
     // load input graph
@@ -52,40 +60,104 @@ int main(int argn, char **argv) {
               << "n(input): " << input_graph.number_of_nodes() << "\n"
               << "m(input): " << input_graph.number_of_edges() << std::endl;
 
-    // construct split graph
-    t.restart();
     spac splitter(input_graph, spac_config.infinity);
-    graph_access &split_graph = splitter.construct_split_graph();
-    std::cout << "split graph construction took " << t.elapsed() << "\n"
-              << "n(split): " << split_graph.number_of_nodes() << "\n"
-              << "m(split): " << split_graph.number_of_edges() << std::endl;
-
-    // partition split graph
-    t.restart();
-    execute_kahip(split_graph, partition_config);
-    std::cout << "kahip took " << t.elapsed() << "\n"
-              << "edge cut: " << quality_metrics().edge_cut(split_graph) << std::endl;
+    std::vector<PartitionID> edge_partition;
+
+    if (spac_config.implicit_split_graph) {
+        // first coarsening level on the view, bounds as in size_constraint_label_propagation
+        t.restart();
+        random_functions::setSeed(partition_config.seed);
+        NodeWeight upper_bound = (1 + partition_config.imbalance / 100.0) * ceil(input_graph.number_of_edges() / (double) partition_config.k);
+        NodeWeight cluster_upper_bound = ceil(upper_bound / (double) partition_config.cluster_coarsening_factor);
+        graph_access &coarse_split_graph = splitter.construct_coarse_split_graph(cluster_upper_bound, partition_config.label_iterations);
+        std::cout << "coarse split graph construction took " << t.elapsed() << "\n"
+                  << "n(coarse split): " << coarse_split_graph.number_of_nodes() << "\n"
+                  << "m(coarse split): " << coarse_split_graph.number_of_edges() << std::endl;
+
+        // partition coarse split graph
+        t.restart();
+        execute_kahip(coarse_split_graph, partition_config);
+        std::cout << "kahip took " << t.elapsed() << "\n"
+                  << "edge cut: " << quality_metrics().edge_cut(coarse_split_graph) << std::endl;
+
+        // project to the split vertices and refine on the view
+        t.restart();
+        edge_partition = splitter.project_partition();
+        splitter.refine_edge_partition(edge_partition, partition_config.k, partition_config.upper_bound_partition,
+                                       partition_config.label_iterations_refinement);
+        std::cout << "refinement took " << t.elapsed() << std::endl;
+    } else {
+        // construct split graph
+        t.restart();
+        graph_access &split_graph = splitter.construct_split_graph();
+        std::cout << "split graph construction took " << t.elapsed() << "\n"
+                  << "n(split): " << split_graph.number_of_nodes() << "\n"
+                  << "m(split): " << split_graph.number_of_edges() << std::endl;
+
+        // partition split graph
+        t.restart();
+        execute_kahip(split_graph, partition_config);
+        std::cout << "kahip took " << t.elapsed() << "\n"
+                  << "edge cut: " << quality_metrics().edge_cut(split_graph) << std::endl;
+
+        edge_partition = splitter.project_partition();
+    }
 
     // evaluate edge partition
     t.restart();
-    splitter.fix_cut_dominant_edges();
-    std::vector<PartitionID> edge_partition = splitter.project_partition();
-    unsigned vertex_cut = splitter.calculate_vertex_cut(edge_partition);
+    splitter.fix_cut_dominant_edges(edge_partition, partition_config.k);
+    unsigned vertex_cut = splitter.calculate_vertex_cut(edge_partition, partition_config.k);
     std::cout << "vertex cut: " << vertex_cut << std::endl;
 
     quality_metrics qm;
     input_graph.set_partition_count(partition_config.k);
     std::cout << "balance: " << qm.edge_balance(input_graph, edge_partition) << std::endl;
 
+    write_edge_partition(edge_partition, partition_config);
+
+    return 0;
+}
+
+static int execute_streaming(const std::string &graph_filename, PartitionConfig &config, SpacConfig &spac_config) {
+    timer t;
+    streaming_edge_partitioner partitioner(config.k, config.imbalance / 100.0, spac_config.hdrf_lambda);
+
+    if (!spac_config.vertex_prior_filename.empty()) {
+        std::vector<PartitionID> prior;
+        std::ifstream in(spac_config.vertex_prior_filename.c_str());
+        PartitionID block;
+        while (in >> block) {
+            prior.push_back(block);
+        }
+        partitioner.set_vertex_prior(prior);
+    }
+
+    // the blocks are written while the edges are streamed
+    if (partitioner.partition(graph_filename, edge_partition_filename(config))) {
+        return 1;
+    }
+    std::cout << "streaming edge partitioning took " << t.elapsed() << "\n"
+              << "n(input): " << partitioner.number_of_nodes() << "\n"
+              << "m(input): " << partitioner.number_of_edges() << std::endl;
+
+    std::cout << "vertex cut: " << partitioner.vertex_cut() << std::endl;
+    std::cout << "balance: " << partitioner.edge_balance() << std::endl;
+
+    return 0;
+}
+
+static std::string edge_partition_filename(PartitionConfig &config) {
     std::stringstream filename;
-    if(!partition_config.filename_output.compare("")) {
-            filename << "tmpedgepartition" << partition_config.k;
+    if(!config.filename_output.compare("")) {
+            filename << "tmpedgepartition" << config.k;
     } else {
-            filename << partition_config.filename_output;
+            filename << config.filename_output;
     }
-    graph_io::writeVector(edge_partition, filename.str());
+    return filename.str();
+}
 
-    return 0;
+static void write_edge_partition(std::vector<PartitionID> &edge_partition, PartitionConfig &config) {
+    graph_io::writeVector(edge_partition, edge_partition_filename(config));
 }
 
 static void execute_kahip(graph_access &G, PartitionConfig &config) {
@@ -26,6 +26,7 @@ cp ./build/kaffpaE deploy/
 cp ./build/graphchecker deploy/
 cp ./build/partition_to_vertex_separator deploy/
 cp ./build/node_separator deploy/
+cp ./build/node_ordering deploy/
 cp ./build/edge_partitioning deploy/
 cp ./build/libinterface_static.a deploy/libkahip.a
 cp ./build/parallel/parallel_src/dsp* ./deploy/distributed_edge_partitioning
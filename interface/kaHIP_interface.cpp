@@ -5,7 +5,9 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
 #include <iostream>
+#include <omp.h>
 #include "kaHIP_interface.h"
 #include "../lib/data_structure/graph_access.h"
 #include "../lib/io/graph_io.h"
@@ -16,8 +18,11 @@
 //#include "../lib/parallel_mh/parallel_mh_async.h"
 #include "../lib/partition/uncoarsening/separator/area_bfs.h"
 #include "../lib/partition/partition_config.h"
+#include "../lib/partition/adaptive_repartitioner.h"
 #include "../lib/partition/graph_partitioner.h"
+#include "../lib/partition/memory_budget.h"
 #include "../lib/partition/uncoarsening/separator/vertex_separator_algorithm.h"
+#include "../lib/node_ordering/nested_dissection.h"
 #include "../app/configuration.h"
 #include "../app/balance_configuration.h"
 
@@ -178,6 +183,240 @@ void kaffpa_balance_NE(int* n,
         internal_kaffpa_call(partition_config, suppress_output, n, vwgt, xadj, adjcwgt, adjncy, nparts, imbalance, edgecut, part);
 }
 
+struct kaffpa_handle_s {
+        // the preconfiguration depends on k, it is recomputed when nparts changes
+        int  mode;
+        PartitionConfig config;
+        bool config_changed;
+
+        PartitionID k;
+        int    seed;
+        double imbalance;
+        double time_limit;
+        double memory_budget;
+        bool   balance_edges;
+
+        // borrowed from the caller
+        int  n;
+        int* vwgt;
+        int* xadj;
+        int* adjcwgt;
+        int* adjncy;
+
+        // rebuilt only after kaffpa_set_graph, its arrays are reused
+        graph_access G;
+        bool graph_changed;
+};
+
+kaffpa_handle kaffpa_create(int mode) {
+        kaffpa_handle handle  = new kaffpa_handle_s();
+        handle->mode          = mode;
+        handle->config_changed = true;
+        handle->k             = 2;
+        handle->seed          = 0;
+        handle->imbalance     = 0.03;
+        handle->time_limit    = 0;
+        handle->memory_budget = 0;
+        handle->balance_edges = false;
+        handle->n             = 0;
+        handle->vwgt          = NULL;
+        handle->xadj          = NULL;
+        handle->adjcwgt       = NULL;
+        handle->adjncy        = NULL;
+        handle->graph_changed = false;
+
+        return handle;
+}
+
+int kaffpa_set_option(kaffpa_handle handle, const char* name, double value) {
+        std::string option(name);
+        if( option == "nparts" ) {
+                if( handle->k != (PartitionID) value ) handle->config_changed = true;
+                handle->k = (PartitionID) value;
+        } else if( option == "imbalance" ) {
+                handle->imbalance = value;
+        } else if( option == "seed" ) {
+                handle->seed = (int) value;
+        } else if( option == "time_limit" ) {
+                handle->time_limit = value;
+        } else if( option == "memory_budget" ) {
+                handle->memory_budget = value;
+        } else if( option == "balance_edges" ) {
+                handle->balance_edges = value != 0;
+        } else {
+                return 1;
+        }
+        return 0;
+}
+
+void kaffpa_set_graph(kaffpa_handle handle, int n, int* vwgt, int* xadj, int* adjcwgt, int* adjncy) {
+        handle->n             = n;
+        handle->vwgt          = vwgt;
+        handle->xadj          = xadj;
+        handle->adjcwgt       = adjcwgt;
+        handle->adjncy        = adjncy;
+        handle->graph_changed = true;
+}
+
+// builds the internal graph if it changed and returns the configuration for the next call
+static PartitionConfig prepare_handle_call(kaffpa_handle handle) {
+        graph_access & G = handle->G;
+        if( handle->graph_changed ) {
+                if( handle->vwgt != NULL && handle->adjcwgt != NULL ) {
+                        G.build_from_metis_weighted(handle->n, handle->xadj, handle->adjncy, handle->vwgt, handle->adjcwgt);
+                } else {
+                        G.build_from_metis(handle->n, handle->xadj, handle->adjncy);
+                        if(handle->vwgt != NULL) {
+                                forall_nodes(G, node) {
+                                        G.setNodeWeight(node, handle->vwgt[node]);
+                                } endfor
+                        }
+                        if(handle->adjcwgt != NULL) {
+                                forall_edges(G, e) {
+                                        G.setEdgeWeight(e, handle->adjcwgt[e]);
+                                } endfor 
+                        }
+                }
+                handle->graph_changed = false;
+        } else {
+                // the graph is reused, the partition of the last call has to be reset and
+                // the node weights restored since balance_edges adds the weighted degrees to them
+                forall_nodes(G, node) {
+                        G.setPartitionIndex(node, 0);
+                        G.setNodeWeight(node, handle->vwgt != NULL ? handle->vwgt[node] : 1);
+                } endfor
+        }
+
+        if( handle->config_changed ) {
+                handle->config.k = handle->k;
+
+                configuration cfg;
+                switch( handle->mode ) {
+                        case FAST: 
+                                cfg.fast(handle->config);
+                                break;
+                        case ECO: 
+                                cfg.eco(handle->config);
+                                break;
+                        case STRONG: 
+                                cfg.strong(handle->config);
+                                break;
+                        case FASTSOCIAL: 
+                                cfg.fastsocial(handle->config);
+                                break;
+                        case ECOSOCIAL: 
+                                cfg.ecosocial(handle->config);
+                                break;
+                        case STRONGSOCIAL: 
+                                cfg.strongsocial(handle->config);
+                                break;
+                        default: 
+                                cfg.eco(handle->config);
+                                break;
+                }
+                handle->config_changed = false;
+        }
+
+        // the partitioner modifies the configuration
+        PartitionConfig partition_config = handle->config;
+        partition_config.seed            = handle->seed;
+        partition_config.imbalance       = 100*handle->imbalance;
+        partition_config.time_limit      = handle->time_limit;
+        partition_config.balance_edges   = handle->balance_edges;
+        partition_config.memory_budget   = std::max(0.0, handle->memory_budget);
+        G.set_partition_count(partition_config.k);
+
+        // the random number generator is thread local, i.e. handles of other threads are not affected
+        random_functions::setSeed(partition_config.seed);
+
+        balance_configuration bc;
+        bc.configurate_balance( partition_config, G);
+        memory_budget::apply( partition_config, G);
+
+        return partition_config;
+}
+
+static void finish_handle_call(kaffpa_handle handle, int* edgecut, int* part) {
+        graph_access & G = handle->G;
+        forall_nodes(G, node) {
+                part[node] = G.getPartitionIndex(node);
+        } endfor
+
+        quality_metrics qm;
+        *edgecut = qm.edge_cut(G);
+}
+
+int kaffpa_partition(kaffpa_handle handle, int* edgecut, int* part) {
+        if( handle->xadj == NULL ) return 1;
+
+        PartitionConfig partition_config = prepare_handle_call(handle);
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(partition_config, handle->G);
+
+        finish_handle_call(handle, edgecut, part);
+        return 0;
+}
+
+int kaffpa_repartition(kaffpa_handle handle, int* old_part, int num_changed_nodes, int* changed_nodes, 
+                       double max_migration, int* edgecut, int* part) {
+        if( handle->xadj == NULL ) return 1;
+
+        PartitionConfig partition_config = prepare_handle_call(handle);
+
+        std::vector< PartitionID > old_partition(handle->n);
+        for( int i = 0; i < handle->n; i++) {
+                // negative entries become >= k, i.e. new nodes
+                old_partition[i] = (PartitionID) old_part[i];
+        }
+        std::vector< NodeID > changed;
+        if( changed_nodes != NULL ) {
+                changed.assign(changed_nodes, changed_nodes + num_changed_nodes);
+        }
+
+        adaptive_repartitioner repartitioner;
+        repartitioner.perform_repartitioning(partition_config, handle->G, old_partition, changed, max_migration);
+
+        finish_handle_call(handle, edgecut, part);
+        return 0;
+}
+
+void kaffpa_destroy(kaffpa_handle handle) {
+        delete handle;
+}
+
+void kaffpa_batch(int num_graphs, int* n, int** vwgt, int** xadj, int** adjcwgt, int** adjncy,
+                  int* nparts, double* imbalance, int* seed, int mode, int num_threads,
+                  int* edgecut, int** part) {
+        if( num_threads <= 0 ) num_threads = omp_get_max_threads();
+
+        // largest graphs first, the dynamic schedule then keeps the threads busy until the end
+        std::vector< std::pair< int, int > > order(num_graphs);
+        for( int i = 0; i < num_graphs; i++) {
+                order[i] = std::make_pair(-xadj[i][n[i]], i);
+        }
+        std::sort(order.begin(), order.end());
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+                // one handle per thread, i.e. its memory is reused for the graphs of the thread
+                kaffpa_handle handle = kaffpa_create(mode);
+
+                #pragma omp for schedule(dynamic, 1)
+                for( int j = 0; j < num_graphs; j++) {
+                        int i = order[j].second;
+                        kaffpa_set_option(handle, "nparts", nparts[i]);
+                        kaffpa_set_option(handle, "imbalance", imbalance[i]);
+                        kaffpa_set_option(handle, "seed", seed[i]);
+                        kaffpa_set_graph(handle, n[i], vwgt == NULL ? NULL : vwgt[i], xadj[i], 
+                                         adjcwgt == NULL ? NULL : adjcwgt[i], adjncy[i]);
+                        kaffpa_partition(handle, &edgecut[i], part[i]);
+                }
+
+                kaffpa_destroy(handle);
+        }
+}
+
 void internal_nodeseparator_call(PartitionConfig & partition_config, 
                           bool suppress_output, 
                           int* n, 
@@ -325,3 +564,65 @@ void node_separator(int* n,
 }
 
 
+
+void node_ordering(int* n, 
+                   int* vwgt, 
+                   int* xadj, 
+                   int* adjcwgt, 
+                   int* adjncy, 
+                   double* imbalance, 
+                   bool suppress_output, 
+                   int seed,
+                   int mode,
+                   int* ordering) {
+        configuration cfg;
+        PartitionConfig partition_config;
+        partition_config.k = 2;
+
+        switch( mode ) {
+                case FAST: 
+                case FASTSOCIAL: 
+                        cfg.fast_separator(partition_config);
+                        break;
+                case ECO: 
+                case ECOSOCIAL: 
+                        cfg.eco_separator(partition_config);
+                        break;
+                case STRONG: 
+                case STRONGSOCIAL: 
+                        cfg.strong_separator(partition_config);
+                        break;
+                default: 
+                        cfg.eco_separator(partition_config);
+                        break;
+        }
+        partition_config.seed        = seed;
+        partition_config.imbalance   = 100*(*imbalance);
+        partition_config.num_threads = omp_get_max_threads();
+
+        streambuf* backup = cout.rdbuf();
+        ofstream ofs;
+        ofs.open("/dev/null");
+        if(suppress_output) {
+               cout.rdbuf(ofs.rdbuf()); 
+        }
+
+        graph_access G;     
+        internal_build_graph( partition_config, n, vwgt, xadj, adjcwgt, adjncy, G);
+
+        area_bfs::m_deepth.resize(G.number_of_nodes());
+        forall_nodes(G, node) {
+                area_bfs::m_deepth[node] = 0;
+        } endfor
+
+        std::vector< NodeID > internal_ordering;
+        nested_dissection nd;
+        nd.perform_nested_dissection(partition_config, G, internal_ordering);
+
+        forall_nodes(G, node) {
+                ordering[node] = internal_ordering[node];
+        } endfor
+
+        ofs.close();
+        cout.rdbuf(backup);
+}
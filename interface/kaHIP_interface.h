@@ -40,6 +40,55 @@ void node_separator(int* n, int* vwgt, int* xadj,
                     double* imbalance,  bool suppress_output, int seed, int mode,
                     int* num_separator_vertices, int** separator); 
 
+// handle based interface: the configuration and the internal graph are kept in the handle
+// and reused by subsequent calls. handles are independent, i.e. several threads can
+// partition at the same time as long as every thread uses its own handle
+typedef struct kaffpa_handle_s* kaffpa_handle;
+
+// mode is one of FAST, ECO, STRONG, FASTSOCIAL, ECOSOCIAL, STRONGSOCIAL
+kaffpa_handle kaffpa_create(int mode);
+
+// options: "nparts" (default 2), "imbalance" (default 0.03), "seed" (default 0),
+// "time_limit" (seconds, default 0), "balance_edges" (0 or 1),
+// "memory_budget" (MB the process may use, default 0 = no budget)
+// returns 0 on success and 1 if the option is unknown
+int kaffpa_set_option(kaffpa_handle handle, const char* name, double value);
+
+// the arrays are borrowed, not copied: they have to stay valid until the next call of
+// kaffpa_set_graph or kaffpa_destroy. call it again after the arrays have been modified
+void kaffpa_set_graph(kaffpa_handle handle, int n, int* vwgt, int* xadj, int* adjcwgt, int* adjncy);
+
+// part has to be an array of n ints, returns 0 on success and 1 if no graph has been set
+int kaffpa_partition(kaffpa_handle handle, int* edgecut, int* part);
+
+// warm started repartitioning of the graph of the handle, e.g. after it changed slightly.
+// old_part[v] is the block of v in the old partition, negative for new nodes.
+// changed_nodes (may be NULL) lists nodes that are assigned from scratch before refinement.
+// the graph is only coarsened inside the blocks of this partition and refined from there.
+// at most max_migration of the total node weight leaves its old block if the balance
+// constraint allows it (negative: no limit)
+int kaffpa_repartition(kaffpa_handle handle, int* old_part, int num_changed_nodes, int* changed_nodes, 
+                       double max_migration, int* edgecut, int* part);
+
+void kaffpa_destroy(kaffpa_handle handle);
+
+// partitions num_graphs independent graphs with num_threads threads (<= 0: omp_get_max_threads()).
+// graph i is given by n[i], vwgt[i], xadj[i], adjcwgt[i], adjncy[i] (vwgt, adjcwgt or their entries may be NULL)
+// and is partitioned into nparts[i] blocks with imbalance[i] and seed[i], the result only depends
+// on these parameters. part[i] has to be an array of n[i] ints
+void kaffpa_batch(int num_graphs, int* n, int** vwgt, int** xadj, int** adjcwgt, int** adjncy,
+                  int* nparts, double* imbalance, int* seed, int mode, int num_threads,
+                  int* edgecut, int** part);
+
+// computes a fill reducing ordering using nested dissection
+// ordering has to be an array of n ints, ordering[v] is the position of v in the elimination order
+// imbalance is the allowed imbalance of the separators (e.g. 0.2 as used by the node_ordering program)
+// the subproblems are ordered in parallel using omp_get_max_threads() threads
+void node_ordering(int* n, int* vwgt, int* xadj, 
+                   int* adjcwgt, int* adjncy, double* imbalance, 
+                   bool suppress_output, int seed, int mode,
+                   int* ordering); 
+
 #ifdef __cplusplus
 }
 #endif
@@ -336,12 +336,16 @@ bool cycle_search::negative_cycle_detection(graph_access & G,
                 cycle.push_back(start_vertex);
                 std::reverse(cycle.begin(), cycle.end());
 
-                total_time += timeR.elapsed();
+                double elapsed = timeR.elapsed();
+                #pragma omp atomic
+                total_time += elapsed;
                 return true;
 
         } 
 
-        total_time += timeR.elapsed();
+        double elapsed = timeR.elapsed();
+        #pragma omp atomic
+        total_time += elapsed;
 	return false;
 
 }
@@ -24,6 +24,7 @@ public:
 
         bool find_shortest_path(graph_access & G, NodeID & start, NodeID & dest, std::vector<NodeID> & cycle); 
 
+        // summed over all threads, updated atomically
         static double total_time;
 private:
 
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * flat_pair_set.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef FLAT_PAIR_SET_Q2V7M1KD
+#define FLAT_PAIR_SET_Q2V7M1KD
+
+#include <algorithm>
+#include <limits>
+#include <stdint.h>
+#include <vector>
+
+#include "definitions.h"
+
+// set of (ordered) node pairs stored in one flat array (open addressing, linear probing).
+// a pair is packed into a single 64 bit key, erase shifts the following entries back
+// so that no tombstones are needed and lookups stay short
+class flat_pair_set {
+public:
+        flat_pair_set() : m_size(0), m_mask(0) {}
+
+        // prepares the table for up to expected_size pairs, the table grows if necessary
+        void reserve( uint64_t expected_size ) {
+                uint64_t capacity = 16;
+                while( capacity < 2 * expected_size ) capacity <<= 1;
+                if( capacity > m_keys.size() ) rehash(capacity);
+        }
+
+        inline bool contains( NodeID lhs, NodeID rhs ) const {
+                if( m_keys.empty() ) return false;
+                uint64_t key = pack(lhs, rhs);
+                for( uint64_t pos = hash(key); ; pos = (pos + 1) & m_mask) {
+                        if( m_keys[pos] == key )   return true;
+                        if( m_keys[pos] == empty_key() ) return false;
+                }
+        }
+
+        inline void insert( NodeID lhs, NodeID rhs ) {
+                if( 2 * (m_size + 1) > m_keys.size() ) rehash(std::max((uint64_t)16, 2 * (uint64_t)m_keys.size()));
+
+                uint64_t key = pack(lhs, rhs);
+                uint64_t pos = hash(key);
+                while( m_keys[pos] != empty_key() ) {
+                        if( m_keys[pos] == key ) return;
+                        pos = (pos + 1) & m_mask;
+                }
+                m_keys[pos] = key;
+                m_size++;
+        }
+
+        inline void erase( NodeID lhs, NodeID rhs ) {
+                if( m_keys.empty() ) return;
+                uint64_t key = pack(lhs, rhs);
+                uint64_t pos = hash(key);
+                while( m_keys[pos] != key ) {
+                        if( m_keys[pos] == empty_key() ) return;
+                        pos = (pos + 1) & m_mask;
+                }
+
+                // backward shift: move entries whose probe sequence passes the hole into it
+                uint64_t hole = pos;
+                for( uint64_t next = (hole + 1) & m_mask; m_keys[next] != empty_key(); next = (next + 1) & m_mask) {
+                        uint64_t home = hash(m_keys[next]);
+                        if( ((next - home) & m_mask) >= ((next - hole) & m_mask) ) {
+                                m_keys[hole] = m_keys[next];
+                                hole         = next;
+                        }
+                }
+                m_keys[hole] = empty_key();
+                m_size--;
+        }
+
+        uint64_t size() const { return m_size; }
+
+private:
+        static inline uint64_t empty_key() { return std::numeric_limits< uint64_t >::max(); }
+
+        static inline uint64_t pack( NodeID lhs, NodeID rhs ) {
+                return ((uint64_t)lhs << 32) | rhs;
+        }
+
+        inline uint64_t hash( uint64_t key ) const {
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return key & m_mask;
+        }
+
+        void rehash( uint64_t capacity ) {
+                std::vector< uint64_t > old_keys(capacity, empty_key());
+                old_keys.swap(m_keys);
+                m_mask = capacity - 1;
+                m_size = 0;
+                for( uint64_t i = 0; i < old_keys.size(); i++) {
+                        if( old_keys[i] == empty_key() ) continue;
+                        uint64_t pos = hash(old_keys[i]);
+                        while( m_keys[pos] != empty_key() ) pos = (pos + 1) & m_mask;
+                        m_keys[pos] = old_keys[i];
+                        m_size++;
+                }
+        }
+
+        uint64_t m_size;
+        uint64_t m_mask;
+        std::vector< uint64_t > m_keys;
+};
+
+
+#endif /* end of include guard: FLAT_PAIR_SET_Q2V7M1KD */
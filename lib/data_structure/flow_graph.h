@@ -8,17 +8,18 @@
 #ifndef FLOW_GRAPH_636S5L2S
 #define FLOW_GRAPH_636S5L2S
 
+#include <vector>
+
 #include "definitions.h"
 
 struct rEdge {
-    NodeID     source;
     NodeID     target;
+    EdgeID     reverse_edge_index;
     FlowType   capacity;
     FlowType   flow;
-    EdgeID     reverse_edge_index;
 
-    rEdge( NodeID source, NodeID target, FlowType capacity, FlowType flow, EdgeID reverse_edge_index) {
-        this->source             = source;
+    rEdge() {}
+    rEdge( NodeID target, FlowType capacity, FlowType flow, EdgeID reverse_edge_index) {
         this->target             = target;
         this->capacity           = capacity;
         this->flow               = flow;
@@ -27,25 +28,37 @@ struct rEdge {
 
 };
 
-// this is a adjacency list implementation of the residual graph
+// this is a CSR implementation of the residual graph
 // for each edge we create, we create a rev edge with cap 0
 // zero capacity edges are residual edges
+//
+// construction is done in two passes: new_edge only records the edge and counts degrees,
+// finish_construction computes the offsets and scatters forward and reverse arcs into
+// one contiguous array (keeping the insertion order of the arcs of each node).
+// edge ids are global, i.e. the reverse edge index can be used with any source node.
 class flow_graph {
 public:
         flow_graph() {
                 m_num_edges = 0;
                 m_num_nodes = 0;
+                m_constructed = true;
         };
 
         virtual ~flow_graph() {};
 
+        // edges is an optional hint on the number of new_edge calls that will follow
         void start_construction(NodeID nodes, EdgeID edges = 0) {
-                m_adjacency_lists.resize(nodes);
                 m_num_nodes = nodes;
-                m_num_edges = edges;
+                m_num_edges = 0;
+                m_constructed = false;
+
+                m_edges.clear();
+                m_staged_edges.clear();
+                m_staged_edges.reserve(edges);
+                m_first_edge.assign(nodes + 1, 0);
         }
  
-        void finish_construction() {};
+        void finish_construction();
 
         NodeID number_of_nodes() {return m_num_nodes;};
         EdgeID number_of_edges() {return m_num_edges;};
@@ -59,64 +72,108 @@ public:
         EdgeID getReverseEdge(NodeID source, EdgeID e);
         
         void new_edge(NodeID source, NodeID target, FlowType capacity) {
-               m_adjacency_lists[source].push_back(rEdge(source, target, capacity, 0, m_adjacency_lists[target].size()));
-               // for each edge we add a reverse edge
-               m_adjacency_lists[target].push_back(rEdge(target, source, 0, 0, m_adjacency_lists[source].size() - 1));
-               m_num_edges += 2;
+                ASSERT_TRUE(!m_constructed);
+                staged_edge edge;
+                edge.source   = source;
+                edge.target   = target;
+                edge.capacity = capacity;
+                m_staged_edges.push_back(edge);
+
+                // for each edge we add a reverse edge
+                m_first_edge[source+1]++;
+                m_first_edge[target+1]++;
+                m_num_edges += 2;
         };
 
-        EdgeID get_first_edge(NodeID node) {return 0;};
-        EdgeID get_first_invalid_edge(NodeID node) {return m_adjacency_lists[node].size();};
+        EdgeID get_first_edge(NodeID node) {return m_first_edge[node];};
+        EdgeID get_first_invalid_edge(NodeID node) {return m_first_edge[node+1];};
 
 
 private:
-        std::vector< std::vector<rEdge> > m_adjacency_lists;
+        struct staged_edge {
+                NodeID   source;
+                NodeID   target;
+                FlowType capacity;
+        };
+
+        std::vector< rEdge >       m_edges;
+        std::vector< EdgeID >      m_first_edge;
+        std::vector< staged_edge > m_staged_edges;
         NodeID m_num_nodes;
-        NodeID m_num_edges;
+        EdgeID m_num_edges;
+        bool   m_constructed;
 };
 
+inline
+void flow_graph::finish_construction() {
+        if(m_constructed) return;
+
+        for( NodeID node = 0; node < m_num_nodes; node++) {
+                m_first_edge[node+1] += m_first_edge[node];
+        }
+
+        m_edges.resize(m_num_edges);
+        std::vector< EdgeID > insert_pos(m_first_edge.begin(), m_first_edge.end() - 1);
+        for( unsigned i = 0; i < m_staged_edges.size(); i++) {
+                const staged_edge & edge = m_staged_edges[i];
+                EdgeID forward = insert_pos[edge.source]++;
+                EdgeID reverse = insert_pos[edge.target]++;
+
+                m_edges[forward] = rEdge(edge.target, edge.capacity, 0, reverse);
+                m_edges[reverse] = rEdge(edge.source, 0, 0, forward);
+        }
+
+        std::vector< staged_edge >().swap(m_staged_edges);
+        m_constructed = true;
+}
+
 inline
 NodeID flow_graph::getEdgeCapacity(NodeID source, EdgeID e) {
+        ASSERT_TRUE(m_constructed);
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].capacity;        
+        return m_edges[e].capacity;        
 #else
-        return m_adjacency_lists.at(source).at(e).capacity;        
+        return m_edges.at(e).capacity;        
 #endif
 };
 
 inline
 void flow_graph::setEdgeFlow(NodeID source, EdgeID e, FlowType flow) {
+        ASSERT_TRUE(m_constructed);
 #ifdef NDEBUG
-        m_adjacency_lists[source][e].flow = flow;        
+        m_edges[e].flow = flow;        
 #else
-        m_adjacency_lists.at(source).at(e).flow = flow;        
+        m_edges.at(e).flow = flow;        
 #endif
 };
 
 inline
 FlowType flow_graph::getEdgeFlow(NodeID source, EdgeID e) {
+        ASSERT_TRUE(m_constructed);
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].flow;        
+        return m_edges[e].flow;        
 #else
-        return m_adjacency_lists.at(source).at(e).flow;        
+        return m_edges.at(e).flow;        
 #endif
 };
 
 inline
 NodeID flow_graph::getEdgeTarget(NodeID source, EdgeID e) {
+        ASSERT_TRUE(m_constructed);
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].target;        
+        return m_edges[e].target;        
 #else
-        return m_adjacency_lists.at(source).at(e).target;        
+        return m_edges.at(e).target;        
 #endif
 };
 
 inline
 EdgeID flow_graph::getReverseEdge(NodeID source, EdgeID e) {
+        ASSERT_TRUE(m_constructed);
 #ifdef NDEBUG
-        return m_adjacency_lists[source][e].reverse_edge_index;
+        return m_edges[e].reverse_edge_index;
 #else
-        return m_adjacency_lists.at(source).at(e).reverse_edge_index;        
+        return m_edges.at(e).reverse_edge_index;        
 #endif
 
 }
@@ -11,6 +11,7 @@
 #include <bitset>
 #include <cassert>
 #include <iostream>
+#include <stdint.h>
 #include <vector>
 
 #include "definitions.h"
@@ -37,6 +38,7 @@ struct coarseningEdge {
 class graph_access;
 
 //construction etc. is encapsulated in basicGraph / access to properties etc. is encapsulated in graph_access
+//basicGraph holds the nodes and edges with their weights, the partition and the edge ratings belong to graph_access
 class basicGraph {
     friend class graph_access;
 
@@ -71,9 +73,7 @@ private:
 
         //resizes property arrays
         m_nodes.resize(n+1);
-        m_refinement_node_props.resize(n+1);
         m_edges.resize(m);
-        m_coarsening_edge_props.resize(m);
 
         m_nodes[node].firstEdge = e;
     }
@@ -107,10 +107,7 @@ private:
     void finish_construction() {
         // inert dummy node
         m_nodes.resize(node+1);
-        m_refinement_node_props.resize(node+1);
-
         m_edges.resize(e);
-        m_coarsening_edge_props.resize(e);
 
         m_building_graph = false;
 
@@ -124,12 +121,8 @@ private:
     }
 
     // %%%%%%%%%%%%%%%%%%% DATA %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
-    // split properties for coarsening and uncoarsening
     std::vector<Node> m_nodes;
     std::vector<Edge> m_edges;
-    
-    std::vector<refinementNode> m_refinement_node_props;
-    std::vector<coarseningEdge> m_coarsening_edge_props;
         
     // construction properties
     bool m_building_graph;
@@ -152,8 +145,8 @@ class complete_boundary;
 class graph_access {
         friend class complete_boundary;
         public:
-                graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basicGraph(); m_separator_block_ID = 2;}
-                virtual ~graph_access(){ delete graphref; };
+                graph_access() { m_max_degree_computed = false; m_max_degree = 0; graphref = new basicGraph(); m_owns_graph = true; m_separator_block_ID = 2;}
+                virtual ~graph_access(){ if(m_owns_graph) delete graphref; };
 
                 /* ============================================================= */
                 /* build methods */
@@ -202,6 +195,11 @@ class graph_access {
                 EdgeRatingType getEdgeRating(EdgeID edge);
                 void setEdgeRating(EdgeID edge, EdgeRatingType rating);
 
+                // the edge ratings are only used while the graph is coarsened. release frees them,
+                // allocate restores them (all ratings 0) before the graph is rated again
+                void release_edge_ratings();
+                void allocate_edge_ratings();
+
                 int* UNSAFE_metis_style_xadj_array();
                 int* UNSAFE_metis_style_adjncy_array();
 
@@ -215,18 +213,37 @@ class graph_access {
                 //Count get_node_queue_index(NodeID node);
 
                 void copy(graph_access & Gcopy);
+
+                // the graph becomes a read-only view of the nodes, edges and weights of G, which have to
+                // outlive it. the partition and the edge ratings stay private, i.e. several views can be
+                // partitioned concurrently. building the graph again detaches it from G
+                void share_graph(graph_access & G);
+
+                // bytes held by the graph
+                uint64_t memory();
         private:
                 basicGraph * graphref;     
+                bool         m_owns_graph;
                 bool         m_max_degree_computed;
                 unsigned int m_partition_count;
                 EdgeWeight   m_max_degree;
                 PartitionID  m_separator_block_ID;
                 std::vector<PartitionID> m_second_partition_index;
+
+                // split properties for coarsening and uncoarsening
+                std::vector<refinementNode> m_refinement_node_props;
+                std::vector<coarseningEdge> m_coarsening_edge_props;
 };
 
 /* graph build methods */
 inline void graph_access::start_construction(NodeID nodes, EdgeID edges) {
+        if(!m_owns_graph) {
+                graphref     = new basicGraph();
+                m_owns_graph = true;
+        }
         graphref->start_construction(nodes, edges);
+        m_refinement_node_props.resize(nodes+1);
+        m_coarsening_edge_props.resize(edges);
 }
 
 inline NodeID graph_access::new_node() {
@@ -239,6 +256,8 @@ inline EdgeID graph_access::new_edge(NodeID source, NodeID target) {
 
 inline void graph_access::finish_construction() {
         graphref->finish_construction();
+        m_refinement_node_props.resize(graphref->number_of_nodes()+1);
+        m_coarsening_edge_props.resize(graphref->number_of_edges());
 }
 
 /* graph access methods */
@@ -297,17 +316,17 @@ inline void graph_access::setSeparatorBlock(PartitionID id) {
 
 inline PartitionID graph_access::getPartitionIndex(NodeID node) {
 #ifdef NDEBUG
-        return graphref->m_refinement_node_props[node].partitionIndex;
+        return m_refinement_node_props[node].partitionIndex;
 #else
-        return graphref->m_refinement_node_props.at(node).partitionIndex;
+        return m_refinement_node_props.at(node).partitionIndex;
 #endif
 }
 
 inline void graph_access::setPartitionIndex(NodeID node, PartitionID id) {
 #ifdef NDEBUG
-        graphref->m_refinement_node_props[node].partitionIndex = id;
+        m_refinement_node_props[node].partitionIndex = id;
 #else
-        graphref->m_refinement_node_props.at(node).partitionIndex = id;
+        m_refinement_node_props.at(node).partitionIndex = id;
 #endif
 }
 
@@ -353,20 +372,30 @@ inline NodeID graph_access::getEdgeTarget(EdgeID edge){
 
 inline EdgeRatingType graph_access::getEdgeRating(EdgeID edge) {
 #ifdef NDEBUG
-        return graphref->m_coarsening_edge_props[edge].rating;        
+        return m_coarsening_edge_props[edge].rating;        
 #else
-        return graphref->m_coarsening_edge_props.at(edge).rating;        
+        return m_coarsening_edge_props.at(edge).rating;        
 #endif
 }
 
 inline void graph_access::setEdgeRating(EdgeID edge, EdgeRatingType rating){
 #ifdef NDEBUG
-        graphref->m_coarsening_edge_props[edge].rating = rating;
+        m_coarsening_edge_props[edge].rating = rating;
 #else
-        graphref->m_coarsening_edge_props.at(edge).rating = rating;
+        m_coarsening_edge_props.at(edge).rating = rating;
 #endif
 }
 
+inline void graph_access::release_edge_ratings() {
+        std::vector<coarseningEdge>().swap(m_coarsening_edge_props);
+}
+
+inline void graph_access::allocate_edge_ratings() {
+        if(m_coarsening_edge_props.size() != graphref->m_edges.size()) {
+                m_coarsening_edge_props.resize(graphref->m_edges.size());
+        }
+}
+
 inline EdgeWeight graph_access::getNodeDegree(NodeID node) {
         return graphref->m_nodes[node+1].firstEdge-graphref->m_nodes[node].firstEdge;
 }
@@ -446,8 +475,10 @@ inline void graph_access::set_partition_count(PartitionID count) {
         m_partition_count = count;
 }
 
+// the arrays of a previously built graph are reused, i.e. rebuilding a graph of at most
+// the same size does not allocate
 inline int graph_access::build_from_metis(int n, int* xadj, int* adjncy) {
-        graphref = new basicGraph();
+        m_max_degree_computed = false;
         start_construction(n, xadj[n]);
 
         for( unsigned i = 0; i < (unsigned)n; i++) {
@@ -467,7 +498,7 @@ inline int graph_access::build_from_metis(int n, int* xadj, int* adjncy) {
 }
 
 inline int graph_access::build_from_metis_weighted(int n, int* xadj, int* adjncy, int * vwgt, int* adjwgt) {
-        graphref = new basicGraph();
+        m_max_degree_computed = false;
         start_construction(n, xadj[n]);
 
         for( unsigned i = 0; i < (unsigned)n; i++) {
@@ -502,4 +533,33 @@ inline void graph_access::copy(graph_access & G_bar) {
         G_bar.finish_construction();
 }
 
+inline void graph_access::share_graph(graph_access & G) {
+        if(m_owns_graph) delete graphref;
+        graphref     = G.graphref;
+        m_owns_graph = false;
+
+        m_max_degree_computed = false;
+        m_max_degree          = 0;
+        m_partition_count     = G.m_partition_count;
+        m_separator_block_ID  = G.m_separator_block_ID;
+
+        m_refinement_node_props.assign(G.m_refinement_node_props.begin(), G.m_refinement_node_props.end());
+        // the ratings are allocated when the graph is rated
+        std::vector<coarseningEdge>().swap(m_coarsening_edge_props);
+}
+
+// a view only counts its private properties
+inline uint64_t graph_access::memory() {
+        uint64_t bytes = sizeof(graph_access)
+                       + m_refinement_node_props.capacity() * sizeof(refinementNode)
+                       + m_coarsening_edge_props.capacity() * sizeof(coarseningEdge)
+                       + m_second_partition_index.capacity() * sizeof(PartitionID);
+        if(m_owns_graph) {
+                bytes += sizeof(basicGraph)
+                       + graphref->m_nodes.capacity() * sizeof(Node)
+                       + graphref->m_edges.capacity() * sizeof(Edge);
+        }
+        return bytes;
+}
+
 #endif /* end of include guard: GRAPH_ACCESS_EFRXO4X2 */
@@ -103,6 +103,16 @@ CoarseMapping * graph_hierarchy::get_mapping_of_current_finer() {
         return m_current_coarse_mapping; 
 }
 
+void graph_hierarchy::release_mapping_of_current_finer() {
+        for( unsigned i = 0; i < m_to_delete_mappings.size(); i++) {
+                if(m_to_delete_mappings[i] == m_current_coarse_mapping) {
+                        m_to_delete_mappings[i] = NULL;
+                }
+        }
+        delete m_current_coarse_mapping;
+        m_current_coarse_mapping = NULL;
+}
+
 graph_access* graph_hierarchy::get_coarsest( ) {
         return m_coarsest_graph;                
 }
@@ -121,3 +131,19 @@ bool graph_hierarchy::isEmpty( ) {
 unsigned int graph_hierarchy::size() {
         return m_the_graph_hierarchy.size();        
 }
+
+uint64_t graph_hierarchy::memory() {
+        uint64_t bytes = 0;
+        std::stack<graph_access*> levels = m_the_graph_hierarchy;
+        while( !levels.empty() ) {
+                bytes += levels.top()->memory();
+                levels.pop();
+        }
+
+        for( unsigned i = 0; i < m_to_delete_mappings.size(); i++) {
+                if(m_to_delete_mappings[i] != NULL) {
+                        bytes += m_to_delete_mappings[i]->capacity() * sizeof(NodeID);
+                }
+        }
+        return bytes;
+}
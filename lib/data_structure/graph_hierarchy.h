@@ -24,9 +24,16 @@ public:
         graph_access  * pop_finer_and_project_ns( PartialBoundary & separator );
         graph_access  * get_coarsest();
         CoarseMapping * get_mapping_of_current_finer();
+
+        // frees the mapping of the current finer graph once it is not needed anymore,
+        // otherwise the mappings of all levels are kept until the hierarchy is destroyed
+        void release_mapping_of_current_finer();
                
         bool isEmpty();
         unsigned int size();
+
+        // bytes held by the graphs that were not popped yet and by the mappings
+        uint64_t memory();
 private:
         //private functions
         graph_access * pop_coarsest();
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * csr_matrix.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef CSR_MATRIX_K3QZ8W1P
+#define CSR_MATRIX_K3QZ8W1P
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "macros_assertions.h"
+#include "matrix.h"
+
+// sparse matrix in compressed row storage, e.g. a communication graph viewed as a matrix.
+// entries that are not stored are zero, only stored entries can be modified
+class csr_matrix final : public matrix {
+public:
+        // adjacency matrix of C, entry (u,v) is the weight of the edge (u,v)
+        csr_matrix( graph_access & C ) : m_dim (C.number_of_nodes()) {
+                m_row_start.resize(m_dim+1, 0);
+                m_columns.reserve(C.number_of_edges());
+                m_values.reserve(C.number_of_edges());
+
+                std::vector< std::pair< NodeID, int > > row;
+                forall_nodes(C, node) {
+                        row.clear();
+                        forall_out_edges(C, e, node) {
+                                row.push_back(std::make_pair(C.getEdgeTarget(e), C.getEdgeWeight(e)));
+                        } endfor
+                        std::sort(row.begin(), row.end());
+
+                        for( unsigned i = 0; i < row.size(); i++) {
+                                // parallel edges are merged
+                                if( m_columns.size() > m_row_start[node] && m_columns.back() == row[i].first ) {
+                                        m_values.back() += row[i].second;
+                                        continue;
+                                }
+                                m_columns.push_back(row[i].first);
+                                m_values.push_back(row[i].second);
+                        }
+                        m_row_start[node+1] = m_columns.size();
+                } endfor
+        };
+
+        virtual ~csr_matrix() {};
+
+        inline int get_xy(unsigned int x, unsigned int y) {
+                unsigned int pos = find(x, y);
+                return pos == NOT_STORED ? 0 : m_values[pos];
+        };
+
+        inline void set_xy(unsigned int x, unsigned int y, int value) {
+                unsigned int pos = find(x, y);
+                ASSERT_TRUE(pos != NOT_STORED || value == 0);
+                if( pos != NOT_STORED ) {
+                        m_values[pos] = value;
+                }
+        };
+
+        inline unsigned int get_x_dim() {return m_dim;};
+        inline unsigned int get_y_dim() {return m_dim;};
+
+        // stored entries of row x are the positions row_begin(x), ..., row_end(x)-1
+        inline unsigned int row_begin( unsigned int x ) const { return m_row_start[x]; }
+        inline unsigned int row_end( unsigned int x ) const   { return m_row_start[x+1]; }
+        inline unsigned int column( unsigned int pos ) const  { return m_columns[pos]; }
+        inline int value( unsigned int pos ) const            { return m_values[pos]; }
+
+        void print() {
+                for( unsigned int i = 0; i < get_x_dim(); i++) {
+                        for( unsigned int j = 0; j < get_y_dim(); j++) {
+                                std::cout <<  get_xy(i,j) << " ";
+                        }
+                        std::cout <<  ""  << std::endl;
+                }
+        }
+
+private:
+        static const unsigned int NOT_STORED = 0xFFFFFFFF;
+
+        inline unsigned int find( unsigned int x, unsigned int y ) const {
+                std::vector< unsigned int >::const_iterator begin = m_columns.begin() + m_row_start[x];
+                std::vector< unsigned int >::const_iterator end   = m_columns.begin() + m_row_start[x+1];
+                std::vector< unsigned int >::const_iterator it    = std::lower_bound(begin, end, y);
+                if( it == end || *it != y ) return NOT_STORED;
+                return it - m_columns.begin();
+        }
+
+        unsigned int m_dim;
+        std::vector< unsigned int > m_row_start;
+        std::vector< unsigned int > m_columns;
+        std::vector< int >          m_values;
+};
+
+
+#endif /* end of include guard: CSR_MATRIX_K3QZ8W1P */
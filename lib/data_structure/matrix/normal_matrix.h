@@ -12,7 +12,7 @@
 #include <iostream>
 #include "matrix.h"
 
-class normal_matrix : public matrix {
+class normal_matrix final : public matrix {
 public:
         normal_matrix(unsigned int dim_x, unsigned int dim_y, int lazy_init_val = 0) : m_dim_x (dim_x), 
                                                                                        m_dim_y (dim_y), 
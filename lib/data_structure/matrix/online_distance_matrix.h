@@ -8,31 +8,86 @@
 #ifndef ONLINE_DISTANCE_MATRIX_DAUJ4JMM
 #define ONLINE_DISTANCE_MATRIX_DAUJ4JMM
 
+#include <algorithm>
+#include <stdint.h>
 #include <vector>
 #include <iostream>
 #include "matrix.h"
+#include "partition_config.h"
 
-class online_distance_matrix : public matrix {
+// distances of a hierarchy (group_sizes, distances) computed on the fly.
+// every PE stores its hierarchy coordinates packed into one word, the digit
+// of the topmost level in the highest bits and bit 0 left empty. the highest
+// differing bit of two coordinates then identifies the level at which the PEs
+// are separated, so a lookup is one xor, one clz and one table access.
+// the class is final so that callers typed on it do not go through the vtable
+class online_distance_matrix final : public matrix {
 public:
         online_distance_matrix(unsigned int dim_x, unsigned int dim_y) : m_dim_x (dim_x), 
-                                                                         m_dim_y (dim_y) {
+                                                                         m_dim_y (dim_y),
+                                                                         m_closed_form (false) {
         };
         
         void setPartitionConfig( PartitionConfig & config ) {
-                this->config = config;
+                m_distances     = config.distances;
+                m_group_sizes   = config.group_sizes;
                 interval_sizes.resize(config.group_sizes.size());
                 interval_sizes[0] = config.group_sizes[0]; 
                 for( unsigned i = 1; i < interval_sizes.size(); i++) {
                         interval_sizes[i] = config.group_sizes[i]*interval_sizes[i-1];
                 }
- 
+
+                // digit j (1 <= j < levels) is the index of a PE's level j-1 group inside its level j group,
+                // the last digit is the index of the topmost group. a difference in digit j yields distances[j]
+                unsigned int levels = interval_sizes.size();
+                unsigned int dim    = std::max(m_dim_x, m_dim_y);
+                std::vector< unsigned int > digit_bits(levels+1, 0);
+                for( unsigned j = 1; j < levels; j++) {
+                        digit_bits[j] = bits_needed(config.group_sizes[j] - 1);
+                }
+                digit_bits[levels] = dim > 0 ? bits_needed((dim - 1) / interval_sizes[levels-1]) : 0;
+
+                unsigned int total_bits = 1;
+                for( unsigned j = 1; j <= levels; j++) {
+                        total_bits += digit_bits[j];
+                }
+
+                m_closed_form = total_bits <= 64;
+                if( !m_closed_form ) return;
+
+                m_bit_distance.assign(64, config.distances[0]);
+                unsigned int offset = 1;
+                for( unsigned j = 1; j <= levels; j++) {
+                        for( unsigned b = 0; b < digit_bits[j]; b++) {
+                                m_bit_distance[offset + b] = config.distances[j];
+                        }
+                        offset += digit_bits[j];
+                }
+
+                m_coordinates.resize(dim);
+                for( unsigned int pe = 0; pe < dim; pe++) {
+                        uint64_t coordinate = 0;
+                        unsigned int shift  = 1;
+                        for( unsigned j = 1; j <= levels; j++) {
+                                uint64_t digit = pe / interval_sizes[j-1];
+                                if( j < levels ) digit %= config.group_sizes[j];
+                                coordinate |= digit << shift;
+                                shift      += digit_bits[j];
+                        }
+                        m_coordinates[pe] = coordinate;
+                }
         }
 
         virtual ~online_distance_matrix() {};
 
         inline int get_xy(unsigned int x, unsigned int y) {
+                if( m_closed_form ) {
+                        uint64_t diff = (m_coordinates[x] ^ m_coordinates[y]) | 1;
+                        return m_bit_distance[63 - __builtin_clzll(diff)];
+                }
+
                 //now depending on x and y, generate distance
-                int k = config.group_sizes.size()-1;
+                int k = m_group_sizes.size()-1;
                 for(;k >= 0; k--) {
                         int interval_a = x / interval_sizes[k];
                         int interval_b = y / interval_sizes[k];
@@ -42,7 +97,7 @@ public:
                 }
                 k++;
 
-                return config.distances[k];
+                return m_distances[k];
         };
 
         inline void set_xy(unsigned int x, unsigned int y, int value) {
@@ -62,10 +117,20 @@ public:
         }
 
 private:
-        PartitionConfig config;
+        static unsigned int bits_needed( unsigned int max_value ) {
+                unsigned int bits = 0;
+                while( bits < 32 && (max_value >> bits) != 0 ) bits++;
+                return bits;
+        }
+
         unsigned int m_dim_x, m_dim_y;
         std::vector< int > interval_sizes;
+        std::vector< int > m_group_sizes;
+        std::vector< int > m_distances;
 
+        bool                    m_closed_form;
+        std::vector< uint64_t > m_coordinates;
+        std::vector< int >      m_bit_distance;
 };
 
 
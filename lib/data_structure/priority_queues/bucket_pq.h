@@ -37,6 +37,8 @@ class bucket_pq : public priority_queue_interface {
 
                 bool contains(NodeID node) override;
 
+                uint64_t memory() override;
+
               private:
                 NodeID     m_elements;
                 EdgeWeight m_gain_span;
@@ -54,6 +56,17 @@ inline bucket_pq::bucket_pq( const EdgeWeight & gain_span_input ) {
         m_buckets.resize(2*m_gain_span+1);
 }
 
+inline uint64_t bucket_pq::memory() {
+        uint64_t bytes = sizeof(bucket_pq)
+                       + m_buckets.capacity()         * sizeof(std::vector<NodeID>)
+                       + m_queue_index.bucket_count() * sizeof(void*)
+                       + m_queue_index.size()         * (sizeof(std::pair<const NodeID, std::pair<Count, Gain> >) + 2*sizeof(void*));
+        for( unsigned i = 0; i < m_buckets.size(); i++) {
+                bytes += m_buckets[i].capacity() * sizeof(NodeID);
+        }
+        return bytes;
+}
+
 inline NodeID bucket_pq::size() {
         return m_elements;
 }
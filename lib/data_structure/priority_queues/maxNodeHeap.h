@@ -83,6 +83,8 @@ class maxNodeHeap : public priority_queue_interface {
                 void changeKey(NodeID node, Gain gain) override;
                 Gain getKey(NodeID node) override;
 
+                uint64_t memory() override;
+
         private:
                 std::vector< PQElement >               m_elements;      // elements that contain the data
                 std::unordered_map<NodeID, int>   m_element_index; // stores index of the node in the m_elements array
@@ -95,6 +97,14 @@ class maxNodeHeap : public priority_queue_interface {
 
 
 
+inline uint64_t maxNodeHeap::memory() {
+        return sizeof(maxNodeHeap)
+             + m_elements.capacity()         * sizeof(PQElement)
+             + m_heap.capacity()             * sizeof(std::pair<Key, int>)
+             + m_element_index.bucket_count() * sizeof(void*)
+             + m_element_index.size()         * (sizeof(std::pair<const NodeID, int>) + 2*sizeof(void*));
+}
+
 inline Gain maxNodeHeap::maxValue() {
         return m_heap[0].first;
 };
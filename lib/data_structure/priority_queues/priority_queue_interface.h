@@ -8,6 +8,8 @@
 #ifndef PRIORITY_QUEUE_INTERFACE_20ZSYG7R
 #define PRIORITY_QUEUE_INTERFACE_20ZSYG7R
 
+#include <stdint.h>
+
 #include "definitions.h"
 
 class priority_queue_interface {
@@ -32,6 +34,9 @@ class priority_queue_interface {
                 virtual Gain getKey(NodeID element)  = 0;
                 virtual void deleteNode(NodeID node) = 0;
                 virtual bool contains(NodeID node)   = 0;
+
+                /* bytes held by the queue */
+                virtual uint64_t memory() = 0;
 };
 
 typedef priority_queue_interface refinement_pq;
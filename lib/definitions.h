@@ -103,7 +103,8 @@ typedef enum {
         MATCHING_RANDOM, 
 	MATCHING_GPA, 
 	MATCHING_RANDOM_GPA,
-        CLUSTER_COARSENING
+        CLUSTER_COARSENING,
+        MATCHING_LOCAL_MAX
 } MatchingType;
 
 typedef enum {
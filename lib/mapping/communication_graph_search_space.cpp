@@ -8,8 +8,6 @@
 #include "communication_graph_search_space.h"
 #include "tools/random_functions.h"
 
-int global_num_nodes = 0;
-
 communication_graph_search_space::communication_graph_search_space(PartitionConfig & config, NodeID number_of_nodes) {
         m_pointer       = 0;
         m_last_pointer  = 0;
@@ -17,7 +15,8 @@ communication_graph_search_space::communication_graph_search_space(PartitionConf
         m_search_deepth = config.communication_neighborhood_dist;
         m_have_to_break = false;
         m_deepth.resize(number_of_nodes);
-        global_num_nodes = number_of_nodes;
+        m_visited.resize(number_of_nodes, 0);
+        m_stamp         = 0;
 	this->config = config;
 }
 
@@ -33,59 +32,21 @@ void communication_graph_search_space::set_graph_ref( graph_access * C) {
                         } endfor
                 } endfor
         } else {
-                std::vector< NodeID > touched_nodes; 
-                std::vector< int > deepth(C->number_of_nodes(), -1);
                 forall_nodes((*C), node) {
-                        touched_nodes.clear();
-
-                        std::queue< NodeID > bfsqueue;
-                        bfsqueue.push(node);
-                        touched_nodes.push_back(node);
-
-                        deepth[node]  = 0;
-                        int cur_deepth  = 0;
-
-                        while(!bfsqueue.empty()) {
-                                NodeID v = bfsqueue.front();
-                                bfsqueue.pop(); 
-
-                                if (deepth[v] == cur_deepth) {
-                                        cur_deepth++;
-                                }
-
-                                if( cur_deepth > config.communication_neighborhood_dist ) {
-                                        break;
-                                }
-
-                                forall_out_edges((*C), e, v) {
-                                        NodeID target = C->getEdgeTarget(e);
-                                        if(deepth[target] == -1) {
-                                                deepth[target] = cur_deepth;
-                                                bfsqueue.push(target);
-                                                touched_nodes.push_back(target);
-                                                m_list_of_pairs.push_back( std::pair< NodeID, NodeID> ( node, target ) );
-                                        }
-                                } endfor
-                        }        
-
-                        for( NodeID v : touched_nodes ) {
-                                deepth[v] = -1;
-                        }
+                        bounded_bfs( &node, 1, config.communication_neighborhood_dist, [&]( NodeID target ) {
+                                        m_list_of_pairs.push_back( std::pair< NodeID, NodeID> ( node, target ) );
+                        });
                 } endfor 
         }
 
         random_functions::permutate_vector_good( m_list_of_pairs);
         m_limit = m_list_of_pairs.size(); 
 
+        m_pair_active.reserve(m_list_of_pairs.size());
 	for( unsigned int i = 0; i < m_list_of_pairs.size(); i++) {
-		m_pair_active[m_list_of_pairs[i]] = true;
+		m_pair_active.insert(m_list_of_pairs[i].first, m_list_of_pairs[i].second);
 	}
 
-        for( unsigned int i = 0; i < m_deepth.size(); i++) {
-                m_deepth[i] = -1;
-        }
-
-
 }
 communication_graph_search_space::~communication_graph_search_space() {
                 
@@ -9,26 +9,12 @@
 #define COMMUNICATION_SEARCH_SPACE_H49ZQ8A4
 
 #include <utility>
-#include <unordered_map>
+#include <vector>
+#include "data_structure/flat_pair_set.h"
 #include "data_structure/graph_access.h"
 #include "tools/random_functions.h"
 #include "partition_config.h"
 
-extern int global_num_nodes;
-
-namespace std {
-        template <>
-                struct hash< std::pair<NodeID, NodeID> > {
-                        public:
-                                size_t operator()(const std::pair<NodeID, NodeID> & x) const throw() {
-                                        if( x.first < x.second ) 
-                                                return x.second*global_num_nodes + x.first;
-                                        else 
-                                                return x.first*global_num_nodes + x.second;
-                                }
-                };
-}
-
 class communication_graph_search_space {
         public:
                 communication_graph_search_space(PartitionConfig & config, NodeID number_of_nodes);
@@ -41,56 +27,23 @@ class communication_graph_search_space {
                 }; // are we done?
 
                 void commit_status( bool success ) {
+                        commit_status( m_list_of_pairs[m_last_pointer], success );
+                }
+
+                // status of a pair returned by an earlier call of nextPair
+                void commit_status( std::pair< NodeID, NodeID > ret_value, bool success ) {
                         if(success) m_unsucc_tries = 0;
                         else m_unsucc_tries++;
 
-                        std::pair< NodeID, NodeID > ret_value = m_list_of_pairs[m_last_pointer];
                         if(!success) {
-                                m_pair_active.erase(ret_value);
+                                m_pair_active.erase(ret_value.first, ret_value.second);
                         } else {
-                                std::queue< NodeID > bfsqueue;
-                                std::vector< NodeID > touched_nodes;
-
-                                bfsqueue.push(ret_value.first);
-                                bfsqueue.push(ret_value.second);
-
-                                m_deepth[ret_value.first]  = 0;
-                                m_deepth[ret_value.second]  = 0;
-                                int cur_deepth  = 0;
-
-                                touched_nodes.push_back( ret_value.first );
-                                touched_nodes.push_back( ret_value.second );
-
-                                while(!bfsqueue.empty()) {
-                                        NodeID node = bfsqueue.front();
-                                        bfsqueue.pop(); 
-
-                                        if (m_deepth[node] == cur_deepth) {
-                                                cur_deepth++;
-                                        }
-
-                                        if( cur_deepth > m_search_deepth ) {
-                                                break;
-                                        }
-
-                                        forall_out_edges((*C), e, node) {
-                                                NodeID target = C->getEdgeTarget(e);
-                                                if(m_deepth[target] == -1) {
-                                                        m_deepth[target] = cur_deepth;
-                                                        bfsqueue.push(target);
-                                                        touched_nodes.push_back(target);
-
-                                                        std::pair< NodeID, NodeID > p1(ret_value.first, target);
-                                                        std::pair< NodeID, NodeID > p2(ret_value.second, target);
-
-                                                        m_pair_active[p1] = true;
-                                                        m_pair_active[p2] = true;
-                                                }
-                                        } endfor
-                                }
-                                for( unsigned i = 0; i < touched_nodes.size(); i++) {
-                                        m_deepth[touched_nodes[i]] = -1;
-                                }
+                                // pairs of the swapped nodes with nodes in their neighborhood become candidates again
+                                NodeID sources[2] = {ret_value.first, ret_value.second};
+                                bounded_bfs( sources, 2, m_search_deepth, [&]( NodeID target ) {
+                                                m_pair_active.insert(ret_value.first, target);
+                                                m_pair_active.insert(ret_value.second, target);
+                                });
                         }
                 }
 
@@ -101,7 +54,7 @@ class communication_graph_search_space {
                         std::pair< NodeID, NodeID > ret_value = m_list_of_pairs[m_pointer++];
                         m_pointer = m_pointer == m_limit ? 0 : m_pointer;
 
-			while( (m_pair_active.find(ret_value) ==  m_pair_active.end()) && m_pointer != starting_pos) {
+			while( !m_pair_active.contains(ret_value.first, ret_value.second) && m_pointer != starting_pos) {
 				m_last_pointer = m_pointer;
 				ret_value      = m_list_of_pairs[m_pointer++];
 				m_pointer      = m_pointer == m_limit ? 0 : m_pointer;
@@ -113,9 +66,48 @@ class communication_graph_search_space {
                 }
 
         private:
+                // breadth first search from sources up to max_depth hops, visit is called for every newly reached node.
+                // the visited marks are timestamps, so nothing has to be reset after a search
+                template < typename visitor >
+                void bounded_bfs( const NodeID* sources, unsigned num_sources, int max_depth, visitor visit ) {
+                        m_stamp++;
+                        if( m_stamp == 0 ) { // overflow
+                                std::fill(m_visited.begin(), m_visited.end(), 0);
+                                m_stamp = 1;
+                        }
+
+                        m_bfs_queue.clear();
+                        for( unsigned i = 0; i < num_sources; i++) {
+                                m_visited[sources[i]] = m_stamp;
+                                m_deepth[sources[i]]  = 0;
+                                m_bfs_queue.push_back(sources[i]);
+                        }
+
+                        for( unsigned head = 0; head < m_bfs_queue.size(); head++) {
+                                NodeID node = m_bfs_queue[head];
+                                int deepth  = m_deepth[node] + 1;
+                                if( deepth > max_depth ) {
+                                        break;
+                                }
+
+                                forall_out_edges((*C), e, node) {
+                                        NodeID target = C->getEdgeTarget(e);
+                                        if( m_visited[target] != m_stamp ) {
+                                                m_visited[target] = m_stamp;
+                                                m_deepth[target]  = deepth;
+                                                m_bfs_queue.push_back(target);
+                                                visit(target);
+                                        }
+                                } endfor
+                        }
+                }
+
                 std::vector< std::pair< NodeID, NodeID > > m_list_of_pairs;                 
-                std::unordered_map< std::pair< NodeID, NodeID>, bool > m_pair_active;                 
+                flat_pair_set m_pair_active;                 
                 std::vector< int > m_deepth;
+                std::vector< unsigned > m_visited;
+                std::vector< NodeID > m_bfs_queue;
+                unsigned m_stamp;
                 int m_limit;
                 int m_pointer;
                 int m_last_pointer;
@@ -35,6 +35,13 @@ void construct_mapping::construct_initial_mapping( PartitionConfig & config, gra
                         PRINT(std::cout <<  "running old growing"  << std::endl;)
                         construct_old_growing( config, C, D, perm_rank);
                         break;
+                case MAP_CONST_OLDGROWING_MATRIX:
+                        {
+                        PRINT(std::cout <<  "running old growing on the sparse communication matrix"  << std::endl;)
+                        csr_matrix C_bar(C);
+                        construct_old_growing_matrix( config, C_bar, D, perm_rank);
+                        }
+                        break;
                 case MAP_CONST_OLDGROWING_FASTER:
                         PRINT(std::cout <<  "running faster growing"  << std::endl;)
                         construct_old_growing_faster( config, C, D, perm_rank);
@@ -54,6 +61,15 @@ void construct_mapping::construct_initial_mapping( PartitionConfig & config, gra
 }
 
 void construct_mapping::construct_old_growing_matrix( PartitionConfig & config, matrix & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        construct_old_growing_matrix_internal( config, C, D, perm_rank );
+}
+
+void construct_mapping::construct_old_growing_matrix( PartitionConfig & config, csr_matrix & C, matrix & D, std::vector< NodeID > & perm_rank) {
+        construct_old_growing_matrix_internal( config, C, D, perm_rank );
+}
+
+template < typename comm_matrix >
+void construct_mapping::construct_old_growing_matrix_internal( PartitionConfig & config, comm_matrix & C, matrix & D, std::vector< NodeID > & perm_rank) {
         std::cout <<  "constructing initial mapping matrix version of growing"  << std::endl;
 
         //initialze perm rank
@@ -65,11 +81,7 @@ void construct_mapping::construct_old_growing_matrix( PartitionConfig & config,
         NodeWeight max_vol      = 0;
         NodeWeight max_vol_elem = 0;
         for( unsigned int i = 0; i < C.get_x_dim(); i++) {
-                NodeWeight cur_vol = 0;
-                for( unsigned int j = 0; j < C.get_x_dim(); j++) {
-                        cur_vol += C.get_xy(i,j);
-                }
-
+                NodeWeight cur_vol = row_volume(C, i);
                 if( cur_vol > max_vol ) {
                         max_vol = cur_vol;
                         max_vol_elem = i;
@@ -115,9 +127,7 @@ void construct_mapping::construct_old_growing_matrix( PartitionConfig & config,
                 total_dist[cpu] += D.get_xy( min_dist_elem, cpu );
         }
 
-        for( unsigned int i = 0; i < C.get_x_dim(); i++) {
-                total_vol[i] += C.get_xy(max_vol_elem, i);
-        }
+        add_row(C, max_vol_elem, total_vol);
 
         while( unassigned_tasks.size() > 0 ) {
                 max_vol      = 0;
@@ -165,11 +175,8 @@ void construct_mapping::construct_old_growing_matrix( PartitionConfig & config,
                         total_dist[cpu] += D.get_xy( cur_PE, cpu );
                 }
 
-                ////update priorities
-                for( unsigned int i = 0; i < unassigned_tasks.size(); i++) {
-                        NodeID target_task = unassigned_tasks[i];
-                        total_vol[target_task] += C.get_xy(cur_task, target_task);
-                }
+                ////update priorities (volumes of assigned tasks are not read anymore)
+                add_row(C, cur_task, total_vol);
 
 
         } 
@@ -9,6 +9,7 @@
 #define CONSTRUCT_MAPPING_LTW749U0
 
 #include "data_structure/graph_access.h"
+#include "data_structure/matrix/csr_matrix.h"
 #include "data_structure/matrix/matrix.h"
 #include "partition_config.h"
 #include "tools/quality_metrics.h"
@@ -23,6 +24,8 @@ class construct_mapping {
 
                 void construct_old_growing( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_old_growing_matrix( PartitionConfig & config, matrix& C, matrix & D, std::vector< NodeID > & perm_rank);
+                // same as above, but only the stored entries of the sparse communication matrix are visited
+                void construct_old_growing_matrix( PartitionConfig & config, csr_matrix & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_old_growing_faster( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_identity( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
                 void construct_random( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
@@ -30,6 +33,38 @@ class construct_mapping {
                 void construct_fast_hierarchy_bottomup( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
 
         private:
+                template < typename comm_matrix >
+                void construct_old_growing_matrix_internal( PartitionConfig & config, comm_matrix & C, matrix & D, std::vector< NodeID > & perm_rank);
+
+                // adds row of C to vol, i.e. vol[j] += C(row, j) for all j
+                inline void add_row( matrix & C, NodeID row, std::vector< NodeWeight > & vol ) {
+                        for( unsigned int j = 0; j < C.get_y_dim(); j++) {
+                                vol[j] += C.get_xy(row, j);
+                        }
+                }
+
+                inline void add_row( csr_matrix & C, NodeID row, std::vector< NodeWeight > & vol ) {
+                        for( unsigned int pos = C.row_begin(row); pos < C.row_end(row); pos++) {
+                                vol[C.column(pos)] += C.value(pos);
+                        }
+                }
+
+                inline NodeWeight row_volume( matrix & C, NodeID row ) {
+                        NodeWeight cur_vol = 0;
+                        for( unsigned int j = 0; j < C.get_y_dim(); j++) {
+                                cur_vol += C.get_xy(row, j);
+                        }
+                        return cur_vol;
+                }
+
+                inline NodeWeight row_volume( csr_matrix & C, NodeID row ) {
+                        NodeWeight cur_vol = 0;
+                        for( unsigned int pos = C.row_begin(row); pos < C.row_end(row); pos++) {
+                                cur_vol += C.value(pos);
+                        }
+                        return cur_vol;
+                }
+
                 int minimumNode(std::vector<int>* nodeAttribs) {
                         int minNode = -1;
                         int minValue = INT_MAX;
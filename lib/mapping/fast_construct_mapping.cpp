@@ -7,13 +7,15 @@
 
 
 #include <fstream>
+#include <limits>
+#include <omp.h>
 
 #include "balance_configuration.h"
 #include "graph_partitioner.h"
 #include "configuration.h"
 #include "partition/uncoarsening/refinement/cycle_improvements/cycle_refinement.h"
 #include "fast_construct_mapping.h"
-#include "tools/graph_extractor.h"
+#include "tools/random_functions.h"
 
 fast_construct_mapping::fast_construct_mapping() {
 
@@ -42,9 +44,8 @@ void fast_construct_mapping::construct_initial_mapping_bottomup_internal( Partit
                 }
         } else {
                 //contract partitioned graph
-                graph_access Q; complete_boundary bnd(&C);
-                bnd.build();
-                bnd.getUnderlyingQuotientGraph(Q);
+                graph_access Q;
+                build_quotient_graph( C, num_parts, Q );
                
                 std::vector< NodeID > rec_ranks( num_parts, 0);
                 construct_initial_mapping_bottomup_internal( config, Q, D, idx+1, rec_ranks);
@@ -65,7 +66,33 @@ void fast_construct_mapping::construct_initial_mapping_topdown( PartitionConfig
                 m_mapping[node] = node;
         } endfor
 
-        construct_initial_mapping_topdown_internal( config, C, config.group_sizes, 0, m_mapping, perm_rank);
+        if( config.num_threads > 1 ) {
+                // the subgroups are partitioned as concurrent tasks, hence std::cout is redirected once for all of them
+                std::streambuf* backup = std::cout.rdbuf();
+                std::ofstream ofs;
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf()); 
+
+                // any thread may execute the root, hence it is seeded explicitly
+                unsigned root_seed         = random_functions::nextInt(0, std::numeric_limits<int>::max());
+                unsigned continuation_seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+
+                #pragma omp parallel num_threads(config.num_threads)
+                {
+                        #pragma omp single
+                        {
+                                random_functions::setSeed(root_seed);
+                                construct_initial_mapping_topdown_internal( config, C, config.group_sizes, 0, m_mapping, perm_rank);
+                        }
+                }
+
+                random_functions::setSeed(continuation_seed);
+
+                ofs.close();
+                std::cout.rdbuf(backup);
+        } else {
+                construct_initial_mapping_topdown_internal( config, C, config.group_sizes, 0, m_mapping, perm_rank);
+        }
 }
 
 void fast_construct_mapping::construct_initial_mapping_topdown_internal( PartitionConfig & config, 
@@ -98,27 +125,138 @@ void fast_construct_mapping::construct_initial_mapping_topdown_internal( Partiti
                         count[block]++;
                 } endfor
         } else {
+                // group the nodes by block in one pass, the subgraphs are then independent of each other
+                std::vector< std::vector< NodeID > > block_nodes( num_parts );
+                std::vector< NodeID > local_id( C.number_of_nodes() );
+                std::vector< EdgeID > block_edges( num_parts, 0 );
+                forall_nodes(C, node) {
+                        PartitionID block = C.getPartitionIndex(node);
+                        local_id[node]    = block_nodes[block].size();
+                        block_nodes[block].push_back(node);
+                        forall_out_edges(C, e, node) {
+                                if( C.getPartitionIndex(C.getEdgeTarget(e)) == block ) {
+                                        block_edges[block]++;
+                                }
+                        } endfor
+                } endfor
+
                 // extract subgraphs and recurse on them
+                // with num_threads > 1 each subgroup is a task that seeds its generator by its position in the hierarchy
                 group_sizes.pop_back();
                 for( PartitionID block = 0; block < num_parts; block++) {
-                        graph_extractor ge; graph_access Q;
-                        std::vector<NodeID> mapping;
-                        ge.extract_block( C, Q, block, mapping);
+                        #pragma omp task if(config.num_threads > 1) default(shared) firstprivate(block)
+                        {
+                                if( config.num_threads > 1 ) {
+                                        random_functions::setSeed(config.seed + count[block]*(config.group_sizes.size()+1) + group_sizes.size());
+                                }
+
+                                graph_access Q;
+                                std::vector<NodeID> mapping;
+                                extract_block( C, block_nodes[block], local_id, block_edges[block], Q );
+
+                                mapping.resize(block_nodes[block].size());
+                                forall_nodes(Q, node) {
+                                        mapping[node] = map_to_original[block_nodes[block][node]];
+                                } endfor
+
+                                construct_initial_mapping_topdown_internal( config, Q, group_sizes, count[block], mapping, perm_rank);
+                        }
+                }
+                #pragma omp taskwait
+        }
+}
+
+void fast_construct_mapping::extract_block( graph_access & C, std::vector< NodeID > & nodes, std::vector< NodeID > & local_id, 
+                                            EdgeID edges, graph_access & Q ) {
+        Q.start_construction(nodes.size(), edges);
+
+        for( unsigned i = 0; i < nodes.size(); i++) {
+                NodeID node       = nodes[i];
+                PartitionID block = C.getPartitionIndex(node);
+                NodeID new_node   = Q.new_node();
+                Q.setNodeWeight( new_node, C.getNodeWeight(node));
+
+                forall_out_edges(C, e, node) {
+                        NodeID target = C.getEdgeTarget(e);
+                        if( C.getPartitionIndex( target ) == block ) {
+                                EdgeID new_edge = Q.new_edge(new_node, local_id[target]);
+                                Q.setEdgeWeight(new_edge, C.getEdgeWeight(e));
+                        }
+                } endfor
+        }
 
-                        forall_nodes(Q, node) {
-                                mapping[node] = map_to_original[mapping[node]];
+        Q.finish_construction();
+}
+
+void fast_construct_mapping::build_quotient_graph( graph_access & C, PartitionID num_parts, graph_access & Q ) {
+        // the buffers are members and reused on all levels of the recursion
+        m_block_start.assign(num_parts+1, 0);
+        m_block_weight.assign(num_parts, 0);
+        m_edge_weight.resize(num_parts, -1); // -1 marks blocks that are not adjacent to the current one
+        m_touched.clear();
+        m_block_nodes.resize(C.number_of_nodes());
+
+        forall_nodes(C, node) {
+                m_block_start[C.getPartitionIndex(node)+1]++;
+        } endfor
+        for( PartitionID block = 0; block < num_parts; block++) {
+                m_block_start[block+1] += m_block_start[block];
+        }
+        m_quotient_start.assign(m_block_start.begin(), m_block_start.end()); // insert positions
+        forall_nodes(C, node) {
+                PartitionID block                          = C.getPartitionIndex(node);
+                m_block_nodes[m_quotient_start[block]++]   = node;
+                m_block_weight[block]                     += C.getNodeWeight(node);
+        } endfor
+
+        // accumulate the cut edges of each block, quotient edges are stored in order of appearance
+        m_edge_targets.clear();
+        m_quotient_edge_weights.clear();
+        m_quotient_start.assign(num_parts+1, 0);
+        for( PartitionID block = 0; block < num_parts; block++) {
+                for( NodeID i = m_block_start[block]; i < m_block_start[block+1]; i++) {
+                        NodeID node = m_block_nodes[i];
+                        forall_out_edges(C, e, node) {
+                                PartitionID target_block = C.getPartitionIndex(C.getEdgeTarget(e));
+                                if( target_block == block ) continue;
+                                if( m_edge_weight[target_block] == -1 ) {
+                                        m_edge_weight[target_block] = 0;
+                                        m_touched.push_back(target_block);
+                                }
+                                m_edge_weight[target_block] += C.getEdgeWeight(e);
                         } endfor
+                }
 
-                        construct_initial_mapping_topdown_internal( config, Q, group_sizes, count[block], mapping, perm_rank);
+                for( unsigned i = 0; i < m_touched.size(); i++) {
+                        m_edge_targets.push_back(m_touched[i]);
+                        m_quotient_edge_weights.push_back(m_edge_weight[m_touched[i]]);
+                        m_edge_weight[m_touched[i]] = -1;
                 }
+                m_touched.clear();
+                m_quotient_start[block+1] = m_edge_targets.size();
         }
+
+        Q.start_construction(num_parts, m_edge_targets.size());
+        for( PartitionID block = 0; block < num_parts; block++) {
+                NodeID node = Q.new_node();
+                Q.setNodeWeight(node, m_block_weight[block]);
+                for( NodeID i = m_quotient_start[block]; i < m_quotient_start[block+1]; i++) {
+                        EdgeID e = Q.new_edge(node, m_edge_targets[i]);
+                        Q.setEdgeWeight(e, m_quotient_edge_weights[i]);
+                }
+        }
+        Q.finish_construction();
 }
 
 void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & config, graph_access & C, PartitionID blocks) {
+        // inside of a parallel region the caller has redirected std::cout already
+        bool redirect = !omp_in_parallel();
         std::streambuf* backup = std::cout.rdbuf();
         std::ofstream ofs;
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
+        if( redirect ) {
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
 
         PartitionConfig partition_config = config;
         configuration cfg; 
@@ -137,6 +275,7 @@ void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & c
         }
 
         partition_config.k = blocks;
+        partition_config.num_threads = 1;
         partition_config.imbalance = 0;
         partition_config.epsilon = 0;
 
@@ -164,6 +303,8 @@ void fast_construct_mapping::partition_C_perfectly_balanced( PartitionConfig & c
                 C.setNodeWeight(node, weights[node]);
         } endfor
 
-        ofs.close();
-        std::cout.rdbuf(backup);
+        if( redirect ) {
+                ofs.close();
+                std::cout.rdbuf(backup);
+        }
 }
@@ -31,10 +31,27 @@ private:
         void construct_initial_mapping_bottomup_internal( PartitionConfig & config, graph_access & C, matrix & D, int idx,  std::vector< NodeID > & perm_rank);
 
 
+        // subgraph induced by nodes, local_id maps the nodes of C to their position in nodes
+        void extract_block( graph_access & C, std::vector< NodeID > & nodes, std::vector< NodeID > & local_id, 
+                            EdgeID edges, graph_access & Q );
+
+        // quotient graph of the partition of C, as complete_boundary::getUnderlyingQuotientGraph
+        void build_quotient_graph( graph_access & C, PartitionID num_parts, graph_access & Q );
+
         void partition_C_perfectly_balanced( PartitionConfig & config, graph_access & C, PartitionID blocks);
 
         int m_tmp_num_nodes;
 
+        // buffers of build_quotient_graph
+        std::vector< NodeID >      m_block_start;
+        std::vector< NodeID >      m_block_nodes;
+        std::vector< NodeWeight >  m_block_weight;
+        std::vector< EdgeWeight >  m_edge_weight;
+        std::vector< PartitionID > m_touched;
+        std::vector< NodeID >      m_edge_targets;
+        std::vector< EdgeWeight >  m_quotient_edge_weights;
+        std::vector< NodeID >      m_quotient_start;
+
 };
 
 #endif /* end of include guard: FAST_CONSTRUCT_MAPPING_1MEOBVNJ */
@@ -28,6 +28,10 @@ public:
                 else m_unsucc_tries++;
 	}
 
+        void commit_status( std::pair< NodeID, NodeID > pair, bool success ) {
+                commit_status(success);
+        }
+
         std::pair< NodeID, NodeID > nextPair() {
                 std::pair< NodeID, NodeID > ret_value(m_swap_lhs, m_swap_rhs);
                 if(  m_swap_rhs+1 < m_number_of_nodes )
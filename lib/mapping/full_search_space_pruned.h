@@ -28,6 +28,10 @@ public:
                 else m_unsucc_tries++;
 	}
 
+        void commit_status( std::pair< NodeID, NodeID > pair, bool success ) {
+                commit_status(success);
+        }
+
         std::pair< NodeID, NodeID > nextPair() {
                 if( m_unsucc_tries > m_ub && m_internal_k+1 != ceil(m_number_of_nodes/(double) config.search_space_s)) {
                         m_internal_k++;
@@ -8,9 +8,12 @@
 #ifndef LOCAL_SEARCH_MAPPING_CCR5FJN
 #define LOCAL_SEARCH_MAPPING_CCR5FJN
 
+#include <algorithm>
+
 #include "partition_config.h"
 #include "data_structure/graph_access.h"
 #include "data_structure/matrix/matrix.h"
+#include "qap_gain_cache.h"
 #include "tools/timer.h"
 #include "tools/quality_metrics.h"
 
@@ -19,12 +22,24 @@ public:
         local_search_mapping();
         virtual ~local_search_mapping();
            
-        template < typename search_space > 
-        void perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank);
+        // distance_matrix is the static type of D, pass a final matrix class to avoid virtual lookups 
+        template < typename search_space, typename distance_matrix > 
+        void perform_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank);
 
 private:
-        bool perform_single_swap(graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
-        void update_node_contribution( graph_access & C, matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+        // evaluates batches of swaps concurrently and applies a conflict free subset of the improving ones
+        template < typename search_space, typename distance_matrix > 
+        void perform_parallel_local_search( PartitionConfig & config, graph_access & C, search_space & fss, 
+                                            distance_matrix & D, std::vector< NodeID > & perm_rank, qap_gain_cache & cache);
+
+        // decrease of the objective if swap_lhs and swap_rhs are swapped, does not modify anything
+        template < typename distance_matrix > 
+        Gain swap_gain(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
+
+        template < typename distance_matrix > 
+        void apply_swap(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs, Gain gain);
+        template < typename distance_matrix > 
+        void update_node_contribution( graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs);
 
         // Data Members
         std::vector< NodeID > node_contribution;
@@ -34,8 +49,8 @@ private:
 
 // input a valid initial mapping
 // output a valid hopefully better mapping
-template < typename search_space > 
-void local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
+template < typename search_space, typename distance_matrix > 
+void local_search_mapping::perform_local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank) {
         timer t; t.restart();
 
         //compute total metric
@@ -58,21 +73,37 @@ void local_search_mapping::perform_local_search( PartitionConfig & config, graph
         search_space fss(config, C.number_of_nodes());
 	fss.set_graph_ref( &C);
 
-        while ( !fss.done() ) {
-                std::pair< NodeID, NodeID > cur_pair = fss.nextPair();
+        // swaps are evaluated without modifying the mapping, most of them are rejected and
+        // their gains stay valid until a swap in their neighborhood is accepted
+        qap_gain_cache cache(C.number_of_nodes());
+        if( config.num_threads > 1 ) {
+                perform_parallel_local_search( config, C, fss, D, perm_rank, cache );
+        } else {
+                while ( !fss.done() ) {
+                        std::pair< NodeID, NodeID > cur_pair = fss.nextPair();
+
+                        NodeID swap_lhs = cur_pair.first;
+                        NodeID swap_rhs = cur_pair.second;
+
+                        if( D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
+                                fss.commit_status(false);
+                                continue; // skipping swaps inside nodes 
+                        }
 
-                NodeID swap_lhs = cur_pair.first;
-                NodeID swap_rhs = cur_pair.second;
+                        Gain gain = 0;
+                        if( !cache.lookup( swap_lhs, swap_rhs, gain ) ) {
+                                gain = swap_gain( C, D, perm_rank, swap_lhs, swap_rhs );
+                                cache.store( swap_lhs, swap_rhs, gain );
+                        }
 
-                if( D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
-                        fss.commit_status(false);
-                        continue; // skipping swaps inside nodes 
+                        if( gain <= 0 ) {
+				fss.commit_status(false);
+                        } else {
+                                apply_swap( C, D, perm_rank, swap_lhs, swap_rhs, gain );
+                                cache.invalidate( C, swap_lhs, swap_rhs );
+				fss.commit_status(true);
+			}
                 }
-                if(!perform_single_swap( C, D, perm_rank, swap_lhs, swap_rhs)) {
-			fss.commit_status(false);
-                } else {
-			fss.commit_status(true);
-		}
         }
 
         if( total_volume != qm.total_qap(C, D, perm_rank)) {
@@ -81,5 +112,158 @@ void local_search_mapping::perform_local_search( PartitionConfig & config, graph
         }
 }
 
+template < typename search_space, typename distance_matrix > 
+void local_search_mapping::perform_parallel_local_search( PartitionConfig & config, graph_access & C, search_space & fss, 
+                                                          distance_matrix & D, std::vector< NodeID > & perm_rank, qap_gain_cache & cache) {
+        unsigned batch_size = std::max(1, config.ls_swap_batch_size);
+        std::vector< std::pair< NodeID, NodeID > > batch;
+        std::vector< Gain > gains;
+        std::vector< unsigned > order;
+        std::vector< bool > accepted;
+
+        // round stamps: endpoints of swaps accepted in the current round and their neighborhoods
+        std::vector< unsigned > swapped(C.number_of_nodes(), 0);
+        std::vector< unsigned > touched(C.number_of_nodes(), 0);
+        unsigned round = 0;
+
+        while ( !fss.done() ) {
+                batch.clear();
+                while( batch.size() < batch_size && !fss.done() ) {
+                        batch.push_back(fss.nextPair());
+                }
+
+                gains.resize(batch.size());
+                #pragma omp parallel for num_threads(config.num_threads) schedule(dynamic, 64)
+                for( unsigned i = 0; i < batch.size(); i++) {
+                        NodeID swap_lhs = batch[i].first;
+                        NodeID swap_rhs = batch[i].second;
+                        if( D.get_xy(perm_rank[swap_lhs], perm_rank[swap_rhs]) == config.distances[0] ) {
+                                gains[i] = 0; // skipping swaps inside nodes 
+                        } else if( !cache.lookup( swap_lhs, swap_rhs, gains[i] ) ) {
+                                gains[i] = swap_gain( C, D, perm_rank, swap_lhs, swap_rhs);
+                        }
+                }
+                for( unsigned i = 0; i < batch.size(); i++) {
+                        cache.store( batch[i].first, batch[i].second, gains[i] );
+                }
+
+                order.clear();
+                for( unsigned i = 0; i < batch.size(); i++) {
+                        if( gains[i] > 0 ) order.push_back(i);
+                }
+                std::sort(order.begin(), order.end(), [&]( unsigned a, unsigned b ) {
+                                return gains[a] > gains[b] || (gains[a] == gains[b] && a < b);
+                });
+
+                // the gain of a swap depends on the ranks of its endpoints and their neighbors,
+                // hence a swap is applied only if none of them has been changed in this round 
+                round++;
+                accepted.assign(batch.size(), false);
+                for( unsigned i = 0; i < order.size(); i++) {
+                        NodeID swap_lhs = batch[order[i]].first;
+                        NodeID swap_rhs = batch[order[i]].second;
+                        bool conflict   = touched[swap_lhs] == round || touched[swap_rhs] == round;
+                        forall_out_edges(C, e, swap_lhs) {
+                                conflict = conflict || swapped[C.getEdgeTarget(e)] == round;
+                        } endfor
+                        forall_out_edges(C, e, swap_rhs) {
+                                conflict = conflict || swapped[C.getEdgeTarget(e)] == round;
+                        } endfor
+                        if( conflict ) continue;
+
+                        apply_swap( C, D, perm_rank, swap_lhs, swap_rhs, gains[order[i]]);
+                        cache.invalidate( C, swap_lhs, swap_rhs );
+                        accepted[order[i]] = true;
+
+                        swapped[swap_lhs] = round;
+                        swapped[swap_rhs] = round;
+                        touched[swap_lhs] = round;
+                        touched[swap_rhs] = round;
+                        forall_out_edges(C, e, swap_lhs) {
+                                touched[C.getEdgeTarget(e)] = round;
+                        } endfor
+                        forall_out_edges(C, e, swap_rhs) {
+                                touched[C.getEdgeTarget(e)] = round;
+                        } endfor
+                }
+
+                // improving swaps that were skipped due to a conflict are not reported and can be found again
+                for( unsigned i = 0; i < batch.size(); i++) {
+                        if( accepted[i] ) {
+                                fss.commit_status( batch[i], true );
+                        } else if( gains[i] <= 0 ) {
+                                fss.commit_status( batch[i], false );
+                        }
+                }
+        }
+}
+
+template < typename distance_matrix > 
+Gain local_search_mapping::swap_gain(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        NodeID perm_rank_lhs = perm_rank[swap_lhs];
+        NodeID perm_rank_rhs = perm_rank[swap_rhs];
+
+        // the edge between the two nodes keeps its distance
+        Gain gain = 0;
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == swap_rhs ) continue;
+                NodeID perm_rank_target = perm_rank[target];
+                gain += C.getEdgeWeight(e)*(D.get_xy(perm_rank_lhs, perm_rank_target) - D.get_xy(perm_rank_rhs, perm_rank_target));
+        } endfor
+        forall_out_edges(C, e, swap_rhs) {
+                NodeID target = C.getEdgeTarget(e);
+                if( target == swap_lhs ) continue;
+                NodeID perm_rank_target = perm_rank[target];
+                gain += C.getEdgeWeight(e)*(D.get_xy(perm_rank_rhs, perm_rank_target) - D.get_xy(perm_rank_lhs, perm_rank_target));
+        } endfor
+
+        // we multiply by two since contributions are on both sides
+        return 2*gain;
+}
+
+template < typename distance_matrix > 
+void local_search_mapping::apply_swap(graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs, Gain gain) {
+        node_contribution[swap_lhs] = 0;
+        node_contribution[swap_rhs] = 0;
+
+        std::swap(perm_rank[swap_lhs], perm_rank[swap_rhs]);
+        update_node_contribution( C, D, perm_rank, swap_lhs, swap_rhs );
+
+        PRINT(std::cout <<  "log> improvement " <<  total_volume - gain <<  " " <<  total_volume << std::endl;)
+        total_volume -= gain;
+}
+
+template < typename distance_matrix > 
+void local_search_mapping::update_node_contribution( graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank, NodeID swap_lhs, NodeID swap_rhs) {
+        forall_out_edges(C, e, swap_lhs) {
+                NodeID target                   = C.getEdgeTarget(e);
+                NodeWeight comm_vol             = C.getEdgeWeight(e);
+                NodeID perm_rank_node           = perm_rank[swap_lhs];
+                NodeID perm_rank_target         = perm_rank[target];
+                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                node_contribution[ swap_lhs ]  += cur_vol;
+
+                // update adjacent node contrib
+                if( target != swap_rhs) {
+                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_rhs], perm_rank_target);
+                        node_contribution[ target ] += cur_vol;
+                }
+        } endfor
+        forall_out_edges(C, e, swap_rhs) {
+                NodeID target                   = C.getEdgeTarget(e);
+                NodeWeight comm_vol             = C.getEdgeWeight(e);
+                NodeID perm_rank_node           = perm_rank[swap_rhs];
+                NodeID perm_rank_target         = perm_rank[target];
+                NodeWeight cur_vol              = comm_vol*D.get_xy(perm_rank_node, perm_rank_target);
+                node_contribution[ swap_rhs ]  += cur_vol;
+
+                if( target != swap_lhs) {
+                        node_contribution[ target ] -= comm_vol*D.get_xy(perm_rank[swap_lhs], perm_rank_target);
+                        node_contribution[ target ] += cur_vol;
+                }
+        } endfor
+}
+
 
 #endif /* end of include guard: LOCAL_SEARCH_MAPPING_CCR5FJN */
@@ -9,6 +9,7 @@
 #include "communication_graph_search_space.h"
 #include "construct_distance_matrix.h"
 #include "construct_mapping.h"
+#include "data_structure/matrix/online_distance_matrix.h"
 #include "full_search_space.h"
 #include "full_search_space_pruned.h"
 #include "local_search_mapping.h"
@@ -24,6 +25,22 @@ mapping_algorithms::~mapping_algorithms() {
 
 }
 
+template < typename distance_matrix >
+static void local_search( PartitionConfig & config, graph_access & C, distance_matrix & D, std::vector< NodeID > & perm_rank) {
+        local_search_mapping lsm;
+        switch( config.ls_neighborhood ) {
+                case NSQUARE:
+                        lsm.perform_local_search< full_search_space, distance_matrix > ( config, C, D, perm_rank);
+                        break;
+                case NSQUAREPRUNED:
+                        lsm.perform_local_search< full_search_space_pruned, distance_matrix > ( config, C, D, perm_rank);
+                        break;
+                case COMMUNICATIONGRAPH:
+                        lsm.perform_local_search< communication_graph_search_space, distance_matrix > ( config, C, D, perm_rank);
+                        break;
+        }
+}
+
 void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_access & C, matrix & D, std::vector< NodeID > & perm_rank) {
         PRINT(std::cout <<  "computing distance matrix "  << std::endl;)
         construct_distance_matrix cdm;
@@ -35,17 +52,15 @@ void mapping_algorithms::construct_a_mapping( PartitionConfig & config, graph_ac
         PRINT(std::cout <<  "construction took " <<  t.elapsed() << std::endl;)
         
         t.restart();
-        local_search_mapping lsm;
-        switch( config.ls_neighborhood ) {
-                case NSQUARE:
-                        lsm.perform_local_search< full_search_space > ( config, C, D, perm_rank);
-                        break;
-                case NSQUAREPRUNED:
-                        lsm.perform_local_search< full_search_space_pruned > ( config, C, D, perm_rank);
-                        break;
-                case COMMUNICATIONGRAPH:
-                        lsm.perform_local_search< communication_graph_search_space > ( config, C, D, perm_rank);
-                        break;
+        // dispatch on the concrete distance matrix so that the distance lookups of the local search are not virtual
+        online_distance_matrix* online_D = dynamic_cast< online_distance_matrix* >( &D );
+        normal_matrix* normal_D          = dynamic_cast< normal_matrix* >( &D );
+        if( online_D != NULL ) {
+                local_search( config, C, *online_D, perm_rank );
+        } else if( normal_D != NULL ) {
+                local_search( config, C, *normal_D, perm_rank );
+        } else {
+                local_search( config, C, D, perm_rank );
         }
 
         PRINT(std::cout <<  "local search took " <<  t.elapsed()  << std::endl;)
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * qap_gain_cache.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef QAP_GAIN_CACHE_T5KD83QX
+#define QAP_GAIN_CACHE_T5KD83QX
+
+#include <limits>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+// direct mapped cache of swap gains of the QAP local search.
+// the gain of a swap depends only on the ranks of its endpoints and of their neighbors.
+// every node carries a version that is increased if its own rank or the rank of a neighbor
+// changes, an entry is valid as long as the versions of both endpoints are unchanged.
+// hence, an accepted swap only has to touch the versions of the swapped nodes and their neighbors
+class qap_gain_cache {
+public:
+        qap_gain_cache( NodeID number_of_nodes, uint64_t max_entries = (1ULL << 20) ) {
+                uint64_t pairs = (uint64_t)number_of_nodes * (number_of_nodes - 1) / 2;
+                uint64_t size  = 1;
+                while( size < pairs && size < max_entries ) size <<= 1;
+
+                m_mask = size - 1;
+                m_entries.resize(size);
+                m_version.resize(number_of_nodes, 1);
+        }
+
+        // returns false if the gain of the pair is unknown or outdated
+        inline bool lookup( NodeID lhs, NodeID rhs, Gain & gain ) const {
+                uint64_t key        = pack(lhs, rhs);
+                const entry & slot  = m_entries[hash(key)];
+                if( slot.key != key || slot.version_lhs != m_version[lhs] || slot.version_rhs != m_version[rhs] ) {
+                        return false;
+                }
+                gain = slot.gain;
+                return true;
+        }
+
+        inline void store( NodeID lhs, NodeID rhs, Gain gain ) {
+                uint64_t key      = pack(lhs, rhs);
+                entry & slot      = m_entries[hash(key)];
+                slot.key          = key;
+                slot.gain         = gain;
+                slot.version_lhs  = m_version[lhs];
+                slot.version_rhs  = m_version[rhs];
+        }
+
+        // to be called after swap_lhs and swap_rhs have been swapped
+        void invalidate( graph_access & C, NodeID swap_lhs, NodeID swap_rhs ) {
+                m_version[swap_lhs]++;
+                m_version[swap_rhs]++;
+                forall_out_edges(C, e, swap_lhs) {
+                        m_version[C.getEdgeTarget(e)]++;
+                } endfor
+                forall_out_edges(C, e, swap_rhs) {
+                        m_version[C.getEdgeTarget(e)]++;
+                } endfor
+        }
+
+private:
+        struct entry {
+                entry() : key(std::numeric_limits< uint64_t >::max()), gain(0), version_lhs(0), version_rhs(0) {}
+                uint64_t key;
+                Gain     gain;
+                unsigned version_lhs;
+                unsigned version_rhs;
+        };
+
+        // the gain is symmetric in its arguments, so is the key
+        static inline uint64_t pack( NodeID lhs, NodeID rhs ) {
+                if( lhs > rhs ) std::swap(lhs, rhs);
+                return ((uint64_t)lhs << 32) | rhs;
+        }
+
+        inline uint64_t hash( uint64_t key ) const {
+                key ^= key >> 33;
+                key *= 0xff51afd7ed558ccdULL;
+                key ^= key >> 33;
+                return key & m_mask;
+        }
+
+        uint64_t m_mask;
+        std::vector< entry >    m_entries;
+        std::vector< unsigned > m_version;
+};
+
+
+#endif /* end of include guard: QAP_GAIN_CACHE_T5KD83QX */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * min_degree_ordering.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "min_degree_ordering.h"
+
+min_degree_ordering::min_degree_ordering() {
+
+}
+
+min_degree_ordering::~min_degree_ordering() {
+
+}
+
+void min_degree_ordering::perform_ordering(graph_access & G, std::vector< NodeID > & ordering) {
+        NodeID n = G.number_of_nodes();
+        ordering.clear();
+        ordering.reserve(n);
+
+        std::vector< std::vector< NodeID > > adjacency(n);
+        forall_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if( target != node ) adjacency[node].push_back(target);
+                } endfor
+        } endfor
+
+        std::vector< NodeID > marker(n, UNDEFINED_NODE);
+
+        // the heap extracts the maximum, i.e. the keys are the negative degrees
+        maxNodeHeap queue;
+        forall_nodes(G, node) {
+                if( adjacency[node].empty() ) {
+                        ordering.push_back(node);
+                } else {
+                        queue.insert(node, -(Gain)adjacency[node].size());
+                }
+        } endfor
+
+        while( !queue.empty() ) {
+                NodeID pivot = queue.deleteMax();
+                ordering.push_back(pivot);
+
+                // the neighbors of the pivot form a clique in the elimination graph
+                std::vector< NodeID > & clique = adjacency[pivot];
+                for( NodeID u : clique ) {
+                        std::vector< NodeID > & neighbors = adjacency[u];
+                        for( unsigned i = 0; i < neighbors.size(); ) {
+                                if( neighbors[i] == pivot ) {
+                                        std::swap(neighbors[i], neighbors.back());
+                                        neighbors.pop_back();
+                                } else {
+                                        marker[neighbors[i++]] = u;
+                                }
+                        }
+
+                        for( NodeID w : clique ) {
+                                if( w != u && marker[w] != u ) {
+                                        marker[w] = u;
+                                        neighbors.push_back(w);
+                                }
+                        }
+                        queue.changeKey(u, -(Gain)neighbors.size());
+                }
+                std::vector< NodeID >().swap(clique);
+        }
+}
@@ -0,0 +1,30 @@
+/******************************************************************************
+ * min_degree_ordering.h 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef MIN_DEGREE_ORDERING_T2WQ7HBE
+#define MIN_DEGREE_ORDERING_T2WQ7HBE
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+// exact minimum degree ordering on the elimination graph
+// intended for the small leaves of the nested dissection, i.e. the elimination graph
+// is stored explicitly. the nodes are kept in a heap keyed by their (negative) degree,
+// hence the pivot is found in O(log n). isolated nodes are eliminated first without fill
+class min_degree_ordering {
+public:
+        min_degree_ordering();
+        virtual ~min_degree_ordering();
+
+        // ordering[i] is the i-th node to eliminate
+        void perform_ordering(graph_access & G, std::vector< NodeID > & ordering);
+};
+
+
+#endif /* end of include guard: MIN_DEGREE_ORDERING_T2WQ7HBE */
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * nested_dissection.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <omp.h>
+
+#include "balance_configuration.h"
+#include "graph_partitioner.h"
+#include "min_degree_ordering.h"
+#include "nested_dissection.h"
+#include "tools/graph_extractor.h"
+#include "tools/random_functions.h"
+
+nested_dissection::nested_dissection() {
+
+}
+
+nested_dissection::~nested_dissection() {
+
+}
+
+void nested_dissection::perform_nested_dissection(const PartitionConfig & config, graph_access & G, std::vector< NodeID > & ordering) {
+        ordering.resize(G.number_of_nodes());
+
+        std::vector< NodeID > mapping(G.number_of_nodes());
+        forall_nodes(G, node) {
+                mapping[node] = node;
+        } endfor
+
+        // the top level separator is computed using all threads, below the subproblems are tasks
+        if( G.number_of_nodes() <= (NodeID)config.dissection_rec_limit ) {
+                order_leaf(G, mapping, 0, ordering);
+        } else {
+                bool separated = compute_separator(config, G, 0);
+                #pragma omp parallel num_threads(config.num_threads)
+                {
+                        #pragma omp single
+                        dissect(config, G, mapping, 0, ordering, separated);
+                } // implicit barrier waits for all tasks
+        }
+}
+
+void nested_dissection::recurse(const PartitionConfig & config, graph_access * G, 
+                                std::vector< NodeID > * mapping, 
+                                NodeID offset, 
+                                std::vector< NodeID > & ordering) {
+
+        if( G->number_of_nodes() <= (NodeID)config.dissection_rec_limit ) {
+                order_leaf(*G, *mapping, offset, ordering);
+        } else {
+                dissect(config, *G, *mapping, offset, ordering, compute_separator(config, *G, offset));
+        }
+
+        delete G;
+        delete mapping;
+}
+
+void nested_dissection::dissect(const PartitionConfig & config, graph_access & G, 
+                                std::vector< NodeID > & mapping, 
+                                NodeID offset, 
+                                std::vector< NodeID > & ordering,
+                                bool separated) {
+        if( separated ) {
+                split(config, G, mapping, offset, ordering);
+        } else if( !split_components(config, G, mapping, offset, ordering) ) {
+                // connected but no separator found
+                order_leaf(G, mapping, offset, ordering);
+        }
+}
+
+void nested_dissection::split(const PartitionConfig & config, graph_access & G, 
+                              std::vector< NodeID > & mapping, 
+                              NodeID offset, 
+                              std::vector< NodeID > & ordering) {
+
+        // the separator gets the last labels of the range [offset, offset+n)
+        NodeID lhs_size = 0;
+        NodeID sep_idx  = offset + G.number_of_nodes();
+        forall_nodes(G, node) {
+                PartitionID block = G.getPartitionIndex(node);
+                if( block == 0 ) {
+                        lhs_size++;
+                } else if( block == G.getSeparatorBlock() ) {
+                        ordering[mapping[node]] = --sep_idx;
+                }
+        } endfor
+
+        graph_extractor extractor;
+        graph_access * lhs = new graph_access();
+        graph_access * rhs = new graph_access();
+        std::vector< NodeID > * lhs_mapping = new std::vector< NodeID >();
+        std::vector< NodeID > * rhs_mapping = new std::vector< NodeID >();
+        extractor.extract_block(G, *lhs, 0, *lhs_mapping);
+        extractor.extract_block(G, *rhs, 1, *rhs_mapping);
+
+        // map back to the ids of the input graph
+        for( NodeID & node : *lhs_mapping ) node = mapping[node];
+        for( NodeID & node : *rhs_mapping ) node = mapping[node];
+
+        // the tasks own the extracted subgraphs, the caller can release G right away
+        const PartitionConfig * cfg  = &config;
+        std::vector< NodeID > * perm = &ordering;
+        NodeID rhs_offset            = offset + lhs_size;
+
+        #pragma omp task firstprivate(cfg, perm, lhs, lhs_mapping, offset)
+        recurse(*cfg, lhs, lhs_mapping, offset, *perm);
+
+        #pragma omp task firstprivate(cfg, perm, rhs, rhs_mapping, rhs_offset)
+        recurse(*cfg, rhs, rhs_mapping, rhs_offset, *perm);
+}
+
+bool nested_dissection::split_components(const PartitionConfig & config, graph_access & G, 
+                                         std::vector< NodeID > & mapping, 
+                                         NodeID offset, 
+                                         std::vector< NodeID > & ordering) {
+        NodeID n = G.number_of_nodes();
+        NodeID next_idx = offset;
+        std::vector< bool > visited(n, false);
+        std::vector< NodeID > local_id(n);
+        std::vector< std::vector< NodeID > > components;
+
+        forall_nodes(G, node) {
+                if( visited[node] ) continue;
+                visited[node] = true;
+
+                if( G.getNodeDegree(node) == 0 ) {
+                        // isolated nodes cause no fill and are numbered right away
+                        ordering[mapping[node]] = next_idx++;
+                        continue;
+                }
+
+                // bfs, the component vector is the queue
+                components.push_back(std::vector< NodeID >(1, node));
+                std::vector< NodeID > & component = components.back();
+                for( NodeID i = 0; i < component.size(); i++) {
+                        NodeID source = component[i];
+                        local_id[source] = i;
+                        forall_out_edges(G, e, source) {
+                                NodeID target = G.getEdgeTarget(e);
+                                if( !visited[target] ) {
+                                        visited[target] = true;
+                                        component.push_back(target);
+                                }
+                        } endfor
+                }
+        } endfor
+
+        if( next_idx == offset && components.size() == 1 ) return false;
+
+        const PartitionConfig * cfg  = &config;
+        std::vector< NodeID > * perm = &ordering;
+        for( std::vector< NodeID > & component : components ) {
+                EdgeID edges = 0;
+                for( NodeID node : component ) edges += G.getNodeDegree(node);
+
+                graph_access * sub = new graph_access();
+                std::vector< NodeID > * sub_mapping = new std::vector< NodeID >();
+                sub_mapping->reserve(component.size());
+                sub->start_construction(component.size(), edges);
+                for( NodeID node : component ) {
+                        NodeID new_node = sub->new_node();
+                        sub_mapping->push_back(mapping[node]);
+                        sub->setNodeWeight(new_node, G.getNodeWeight(node));
+                        forall_out_edges(G, e, node) {
+                                EdgeID new_edge = sub->new_edge(new_node, local_id[G.getEdgeTarget(e)]);
+                                sub->setEdgeWeight(new_edge, G.getEdgeWeight(e));
+                        } endfor
+                }
+                sub->finish_construction();
+
+                NodeID sub_offset = next_idx;
+                next_idx += component.size();
+                std::vector< NodeID >().swap(component);
+
+                #pragma omp task firstprivate(cfg, perm, sub, sub_mapping, sub_offset)
+                recurse(*cfg, sub, sub_mapping, sub_offset, *perm);
+        }
+
+        return true;
+}
+
+void nested_dissection::order_leaf(graph_access & G, 
+                                   std::vector< NodeID > & mapping, 
+                                   NodeID offset, 
+                                   std::vector< NodeID > & ordering) {
+        min_degree_ordering mdo;
+        std::vector< NodeID > elimination_order;
+        mdo.perform_ordering(G, elimination_order);
+
+        for( unsigned i = 0; i < elimination_order.size(); i++) {
+                ordering[mapping[elimination_order[i]]] = offset + i;
+        }
+}
+
+bool nested_dissection::compute_separator(const PartitionConfig & config, graph_access & G, NodeID offset) {
+        if( G.number_of_edges() == 0 ) return false;
+
+        PartitionConfig sep_config       = config;
+        sep_config.k                    = 2;
+        sep_config.mode_node_separators = true;
+        sep_config.balance_edges        = false;
+        if( omp_in_parallel() ) {
+                // subproblems are already running as tasks
+                sep_config.num_threads = 1;
+        }
+
+        G.set_partition_count(2);
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, 0);
+        } endfor
+
+        balance_configuration bc;
+        bc.configurate_balance(sep_config, G);
+
+        // subproblems are ordered concurrently, hence the seed only depends on the subproblem
+        random_functions::setSeed(config.seed + offset + 31 * G.number_of_nodes());
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(sep_config, G);
+
+        NodeID lhs_size = 0;
+        NodeID rhs_size = 0;
+        forall_nodes(G, node) {
+                PartitionID block = G.getPartitionIndex(node);
+                if( block == 0 ) lhs_size++;
+                else if( block == 1 ) rhs_size++;
+        } endfor
+
+        return lhs_size < G.number_of_nodes() && rhs_size < G.number_of_nodes();
+}
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * nested_dissection.h 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef NESTED_DISSECTION_N8XK2PLC
+#define NESTED_DISSECTION_N8XK2PLC
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+#include "partition_config.h"
+
+// computes a fill reducing ordering by recursively computing node separators.
+// the two sides of a separator are extracted and ordered as independent (parallel) tasks,
+// the separator nodes are numbered last. subgraphs with at most config.dissection_rec_limit
+// nodes are ordered using minimum degree. larger subgraphs without a separator are split
+// into their connected components, isolated nodes are numbered directly.
+class nested_dissection {
+public:
+        nested_dissection();
+        virtual ~nested_dissection();
+
+        // ordering[v] is the position of v in the elimination order
+        // the separator configuration (e.g. eco_separator) has to be set by the caller.
+        // the separator computations of concurrent tasks write to std::cout, callers that
+        // do not want their interleaved output have to redirect it
+        void perform_nested_dissection(const PartitionConfig & config, graph_access & G, std::vector< NodeID > & ordering);
+
+private:
+        // takes ownership of G and mapping (mapping[v] is the id of v in the input graph)
+        void recurse(const PartitionConfig & config, graph_access * G, 
+                     std::vector< NodeID > * mapping, 
+                     NodeID offset, 
+                     std::vector< NodeID > & ordering);
+
+        // numbers the separator of G and spawns tasks for both sides
+        void split(const PartitionConfig & config, graph_access & G, 
+                   std::vector< NodeID > & mapping, 
+                   NodeID offset, 
+                   std::vector< NodeID > & ordering);
+
+        // splits G using the separator found by compute_separator (separated) or 
+        // into its connected components, G is ordered directly if neither is possible
+        void dissect(const PartitionConfig & config, graph_access & G, 
+                     std::vector< NodeID > & mapping, 
+                     NodeID offset, 
+                     std::vector< NodeID > & ordering,
+                     bool separated);
+
+        // numbers the isolated nodes of G and spawns a task for each other connected component
+        // returns false if G is connected
+        bool split_components(const PartitionConfig & config, graph_access & G, 
+                              std::vector< NodeID > & mapping, 
+                              NodeID offset, 
+                              std::vector< NodeID > & ordering);
+
+        void order_leaf(graph_access & G, 
+                        std::vector< NodeID > & mapping, 
+                        NodeID offset, 
+                        std::vector< NodeID > & ordering);
+
+        // returns false if no separator splitting the graph could be found
+        bool compute_separator(const PartitionConfig & config, graph_access & G, NodeID offset);
+};
+
+
+#endif /* end of include guard: NESTED_DISSECTION_N8XK2PLC */
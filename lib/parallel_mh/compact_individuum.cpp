@@ -0,0 +1,194 @@
+/******************************************************************************
+ * compact_individuum.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "compact_individuum.h"
+
+packed_partition_ptr packed_partition::pack( const int* partition_map, NodeID n, const packed_partition_ptr & parent ) {
+        packed_partition* packed = new packed_partition();
+        packed->m_n = n;
+
+        // copies only refer to parents that are stored in full
+        packed_partition_ptr reference = parent;
+        if( reference && reference->m_parent ) {
+                reference = reference->m_parent;
+        }
+
+        if( reference && reference->m_n == n ) {
+                std::vector< NodeID > changed;
+                for( NodeID node = 0; node < n; node++) {
+                        if( reference->get_packed(node) != (PartitionID)partition_map[node] ) {
+                                changed.push_back(node);
+                        }
+                }
+
+                // a change costs a node and a block id, keep it if the copy is at most half the size
+                uint64_t delta_bits = (uint64_t)changed.size() * 8 * (sizeof(NodeID) + sizeof(PartitionID));
+                if( 2 * delta_bits <= (uint64_t)n * reference->m_bits ) {
+                        packed->m_parent = reference;
+                        packed->m_bits   = reference->m_bits;
+                        packed->m_changed_nodes.swap(changed);
+                        packed->m_changed_blocks.resize(packed->m_changed_nodes.size());
+                        for( unsigned i = 0; i < packed->m_changed_nodes.size(); i++) {
+                                packed->m_changed_blocks[i] = partition_map[packed->m_changed_nodes[i]];
+                        }
+                        return packed_partition_ptr(packed);
+                }
+        }
+
+        int max_block = 0;
+        for( NodeID node = 0; node < n; node++) {
+                max_block = std::max(max_block, partition_map[node]);
+        }
+
+        packed->m_bits = 1;
+        while( (1ULL << packed->m_bits) <= (uint64_t)max_block ) {
+                packed->m_bits++;
+        }
+
+        packed->m_words.resize(((uint64_t)n * packed->m_bits + 63) / 64, 0);
+        for( NodeID node = 0; node < n; node++) {
+                uint64_t bit    = (uint64_t)node * packed->m_bits;
+                uint64_t word   = bit >> 6;
+                unsigned offset = bit & 63;
+                uint64_t value  = (uint64_t)partition_map[node];
+
+                packed->m_words[word] |= value << offset;
+                if( offset + packed->m_bits > 64 ) {
+                        packed->m_words[word+1] |= value >> (64 - offset);
+                }
+        }
+
+        return packed_partition_ptr(packed);
+}
+
+PartitionID packed_partition::get( NodeID node ) const {
+        if( m_parent ) {
+                std::vector< NodeID >::const_iterator it = std::lower_bound(m_changed_nodes.begin(), m_changed_nodes.end(), node);
+                if( it != m_changed_nodes.end() && *it == node ) {
+                        return m_changed_blocks[it - m_changed_nodes.begin()];
+                }
+                return m_parent->get_packed(node);
+        }
+        return get_packed(node);
+}
+
+void packed_partition::unpack( int* partition_map ) const {
+        if( m_parent ) {
+                m_parent->unpack(partition_map);
+                for( unsigned i = 0; i < m_changed_nodes.size(); i++) {
+                        partition_map[m_changed_nodes[i]] = m_changed_blocks[i];
+                }
+                return;
+        }
+
+        for( NodeID node = 0; node < m_n; node++) {
+                partition_map[node] = get_packed(node);
+        }
+}
+
+void packed_partition::apply( graph_access & G ) const {
+        if( m_parent ) {
+                m_parent->apply(G);
+                for( unsigned i = 0; i < m_changed_nodes.size(); i++) {
+                        G.setPartitionIndex(m_changed_nodes[i], m_changed_blocks[i]);
+                }
+                return;
+        }
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, get_packed(node));
+        } endfor
+}
+
+void packed_partition::apply_second( graph_access & G ) const {
+        if( m_parent ) {
+                m_parent->apply_second(G);
+                for( unsigned i = 0; i < m_changed_nodes.size(); i++) {
+                        G.setSecondPartitionIndex(m_changed_nodes[i], m_changed_blocks[i]);
+                }
+                return;
+        }
+
+        forall_nodes(G, node) {
+                G.setSecondPartitionIndex(node, get_packed(node));
+        } endfor
+}
+
+uint64_t packed_partition::memory() const {
+        return m_words.size() * sizeof(uint64_t)
+             + m_changed_nodes.size() * (sizeof(NodeID) + sizeof(PartitionID));
+}
+
+packed_edge_set::packed_edge_set( const std::vector< EdgeID > & sorted_edges ) {
+        m_size = sorted_edges.size();
+        m_bytes.reserve(m_size);
+
+        EdgeID prev = 0;
+        for( unsigned i = 0; i < sorted_edges.size(); i++) {
+                uint64_t gap = sorted_edges[i] - prev;
+                prev         = sorted_edges[i];
+                while( gap >= 128 ) {
+                        m_bytes.push_back((uint8_t)(gap & 127) | 128);
+                        gap >>= 7;
+                }
+                m_bytes.push_back((uint8_t)gap);
+        }
+        m_bytes.shrink_to_fit();
+}
+
+packed_edge_set_ptr packed_edge_set::cut_edges( graph_access & G, const int* partition_map ) {
+        std::vector< EdgeID > cut_edges;
+        forall_nodes(G, node) {
+                forall_out_edges(G, e, node) {
+                        NodeID target = G.getEdgeTarget(e);
+                        if(partition_map[node] != partition_map[target]) {
+                                cut_edges.push_back(e);
+                        }
+                } endfor
+        } endfor
+
+        return packed_edge_set_ptr(new packed_edge_set(cut_edges));
+}
+
+void packed_edge_set::unpack( std::vector< EdgeID > & edges ) const {
+        edges.clear();
+        edges.reserve(m_size);
+
+        decoder d(*this);
+        while( d.has_next() ) {
+                edges.push_back(d.next());
+        }
+}
+
+unsigned packed_edge_set::symmetric_difference_size( const packed_edge_set & a, const packed_edge_set & b ) {
+        decoder da(a);
+        decoder db(b);
+
+        unsigned common = 0;
+        if( da.has_next() && db.has_next() ) {
+                EdgeID ea = da.next();
+                EdgeID eb = db.next();
+                while( true ) {
+                        if( ea < eb ) {
+                                if( !da.has_next() ) break;
+                                ea = da.next();
+                        } else if( eb < ea ) {
+                                if( !db.has_next() ) break;
+                                eb = db.next();
+                        } else {
+                                common++;
+                                if( !da.has_next() || !db.has_next() ) break;
+                                ea = da.next();
+                                eb = db.next();
+                        }
+                }
+        }
+
+        return a.m_size + b.m_size - 2 * common;
+}
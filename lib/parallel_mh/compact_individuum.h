@@ -0,0 +1,110 @@
+/******************************************************************************
+ * compact_individuum.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef COMPACT_INDIVIDUUM_R8MJ2W5N
+#define COMPACT_INDIVIDUUM_R8MJ2W5N
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+class packed_partition;
+class packed_edge_set;
+
+typedef std::shared_ptr< const packed_partition > packed_partition_ptr;
+typedef std::shared_ptr< const packed_edge_set >  packed_edge_set_ptr;
+
+// immutable partition map storing ceil(log2 k) bits per node.
+// a map that differs from its parent on few nodes stores only these nodes and
+// shares the parent (copy-on-write), the parent itself is always stored in full
+class packed_partition {
+public:
+        static packed_partition_ptr pack( const int* partition_map, NodeID n,
+                                          const packed_partition_ptr & parent = packed_partition_ptr() );
+
+        NodeID size() const { return m_n; }
+        PartitionID get( NodeID node ) const;
+
+        void unpack( int* partition_map ) const;
+        void apply( graph_access & G ) const;
+        void apply_second( graph_access & G ) const;
+
+        // bytes owned by this map (a shared parent is not included)
+        uint64_t memory() const;
+
+private:
+        packed_partition() : m_n(0), m_bits(0) {}
+
+        inline PartitionID get_packed( NodeID node ) const {
+                uint64_t bit    = (uint64_t)node * m_bits;
+                uint64_t word   = bit >> 6;
+                unsigned offset = bit & 63;
+                uint64_t value  = m_words[word] >> offset;
+                if( offset + m_bits > 64 ) {
+                        value |= m_words[word+1] << (64 - offset);
+                }
+                return value & ((1ULL << m_bits) - 1);
+        }
+
+        NodeID   m_n;
+        unsigned m_bits;
+        std::vector< uint64_t > m_words;
+
+        // set if only the differences to m_parent are stored, sorted by node
+        packed_partition_ptr      m_parent;
+        std::vector< NodeID >     m_changed_nodes;
+        std::vector< PartitionID> m_changed_blocks;
+};
+
+// immutable sorted set of edge ids, stored as varint encoded gaps
+class packed_edge_set {
+public:
+        packed_edge_set( const std::vector< EdgeID > & sorted_edges );
+
+        // the cut edges of G under partition_map
+        static packed_edge_set_ptr cut_edges( graph_access & G, const int* partition_map );
+
+        unsigned size() const { return m_size; }
+        void unpack( std::vector< EdgeID > & edges ) const;
+        uint64_t memory() const { return m_bytes.size(); }
+
+        static unsigned symmetric_difference_size( const packed_edge_set & a, const packed_edge_set & b );
+
+private:
+        class decoder {
+        public:
+                decoder( const packed_edge_set & set ) : m_set(set), m_pos(0), m_left(set.m_size), m_value(0) {}
+                bool has_next() const { return m_left > 0; }
+                EdgeID next() {
+                        uint64_t gap = 0;
+                        unsigned shift = 0;
+                        uint8_t byte;
+                        do {
+                                byte   = m_set.m_bytes[m_pos++];
+                                gap   |= (uint64_t)(byte & 127) << shift;
+                                shift += 7;
+                        } while( byte & 128 );
+                        m_value += gap;
+                        m_left--;
+                        return m_value;
+                }
+        private:
+                const packed_edge_set & m_set;
+                uint64_t m_pos;
+                unsigned m_left;
+                EdgeID   m_value;
+        };
+
+        unsigned m_size;
+        std::vector< uint8_t > m_bytes;
+};
+
+
+#endif /* end of include guard: COMPACT_INDIVIDUUM_R8MJ2W5N */
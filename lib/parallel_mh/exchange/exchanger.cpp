@@ -145,25 +145,21 @@ void exchanger::exchange_individum( const PartitionConfig & config,  graph_acces
         //recv. edge cut, partition_map, cut_edges from "from"
         //send in to "to"
 
+        int* send_map      = new int[G.number_of_nodes()];
         int* partition_map = new int[G.number_of_nodes()];
-        out.partition_map  = partition_map;
-        out.cut_edges      = new std::vector<EdgeID>();
+        in.partition_map->unpack(send_map);
 
         MPI_Status st;
-        MPI_Sendrecv( in.partition_map , G.number_of_nodes(), MPI_INT, to, 0, 
-                      out.partition_map, G.number_of_nodes(), MPI_INT, from, 0, m_communicator, &st); 
+        MPI_Sendrecv( send_map     , G.number_of_nodes(), MPI_INT, to, 0, 
+                      partition_map, G.number_of_nodes(), MPI_INT, from, 0, m_communicator, &st); 
 
         //recompute cut edges and edge cut locally
-        forall_nodes(G, node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        if(partition_map[node] != partition_map[target]) {
-                                out.cut_edges->push_back(e);
-                        }
-                } endfor
-        } endfor
+        out.objective     = m_qm.objective(config, G, partition_map);
+        out.partition_map = packed_partition::pack(partition_map, G.number_of_nodes());
+        out.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
 
-        out.objective = m_qm.objective(config, G, partition_map);
+        delete[] send_map;
+        delete[] partition_map;
 }
 
 
@@ -254,23 +250,16 @@ void exchanger::recv_incoming( PartitionConfig & config, graph_access & G, popul
         while(flag) {
                 Individuum out;
                 int* partition_map = new int[G.number_of_nodes()];
-                out.partition_map  = partition_map;
-                out.cut_edges      = new std::vector<EdgeID>();
 
                 MPI_Status rst;
-                MPI_Recv( out.partition_map, G.number_of_nodes(), MPI_INT, st.MPI_SOURCE, rank, m_communicator, &rst); 
+                MPI_Recv( partition_map, G.number_of_nodes(), MPI_INT, st.MPI_SOURCE, rank, m_communicator, &rst); 
                 
                 //recompute cut edges and edge cut locally
-                forall_nodes(G, node) {
-                        forall_out_edges(G, e, node) {
-                                NodeID target = G.getEdgeTarget(e);
-                                if(partition_map[node] != partition_map[target]) {
-                                        out.cut_edges->push_back(e);
-                                }
-                        } endfor
-                } endfor
+                out.objective     = m_qm.objective(config, G, partition_map);
+                out.partition_map = packed_partition::pack(partition_map, G.number_of_nodes());
+                out.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
+                delete[] partition_map;
 
-                out.objective = m_qm.objective(config, G, partition_map);
                 island.insert( G, out );
 
                 if( (unsigned)out.objective < (unsigned)m_prev_best_objective) {
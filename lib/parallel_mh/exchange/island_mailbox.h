@@ -0,0 +1,73 @@
+/******************************************************************************
+ * island_mailbox.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef ISLAND_MAILBOX_Q7ZK2M4T
+#define ISLAND_MAILBOX_Q7ZK2M4T
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+// lock-free multi-producer single-consumer queue of partition maps
+// any island may push, only the owning island takes messages out
+class island_mailbox {
+public:
+        struct message {
+                int* partition_map;
+                int  sender;
+        };
+
+        island_mailbox() : m_head(NULL) {}
+
+        virtual ~island_mailbox() {
+                std::vector< message > left;
+                take_all(left);
+                for( unsigned i = 0; i < left.size(); i++) {
+                        delete[] left[i].partition_map;
+                }
+        }
+
+        // the mailbox takes ownership of partition_map
+        void push( int* partition_map, int sender ) {
+                message_node* node  = new message_node;
+                node->msg.partition_map = partition_map;
+                node->msg.sender        = sender;
+                node->next              = m_head.load(std::memory_order_relaxed);
+                while( !m_head.compare_exchange_weak(node->next, node,
+                                                     std::memory_order_release,
+                                                     std::memory_order_relaxed) ) {}
+        }
+
+        bool empty() {
+                return m_head.load(std::memory_order_acquire) == NULL;
+        }
+
+        // appends all pending messages in the order in which they have been pushed
+        // the caller takes ownership of the partition maps
+        void take_all( std::vector< message > & messages ) {
+                message_node* node = m_head.exchange(NULL, std::memory_order_acquire);
+                unsigned first     = messages.size();
+                while( node != NULL ) {
+                        messages.push_back(node->msg);
+                        message_node* next = node->next;
+                        delete node;
+                        node = next;
+                }
+                std::reverse(messages.begin() + first, messages.end());
+        }
+
+private:
+        struct message_node {
+                message       msg;
+                message_node* next;
+        };
+
+        std::atomic< message_node* > m_head;
+};
+
+
+#endif /* end of include guard: ISLAND_MAILBOX_Q7ZK2M4T */
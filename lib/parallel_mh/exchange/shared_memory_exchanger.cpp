@@ -0,0 +1,146 @@
+/******************************************************************************
+ * shared_memory_exchanger.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <math.h>
+#include <omp.h>
+
+#include "shared_memory_exchanger.h"
+#include "tools/random_functions.h"
+
+shared_memory_exchanger::shared_memory_exchanger( std::vector< island_mailbox > & mailboxes, int island_id )
+        : m_mailboxes(mailboxes), m_island_id(island_id) {
+        m_prev_best_objective = std::numeric_limits<EdgeWeight>::max();
+
+        int num_islands  = m_mailboxes.size();
+        m_cur_num_pushes = 0;
+        if(num_islands > 2) m_max_num_pushes = ceil(log2(num_islands));
+        else                m_max_num_pushes = 1;
+
+        m_allready_send_to.resize(num_islands, false);
+        m_allready_send_to[m_island_id] = true;
+}
+
+shared_memory_exchanger::~shared_memory_exchanger() {
+}
+
+void shared_memory_exchanger::to_individuum( const PartitionConfig & config, graph_access & G,
+                                             int* partition_map, Individuum & out) {
+        //recompute cut edges and edge cut locally
+        out.objective     = m_qm.objective(config, G, partition_map);
+        out.partition_map = packed_partition::pack(partition_map, G.number_of_nodes());
+        out.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
+        delete[] partition_map;
+}
+
+void shared_memory_exchanger::quick_start( PartitionConfig & config, graph_access & G, population & island ) {
+        int num_islands = m_mailboxes.size();
+
+        unsigned no_of_individuals = ceil(config.mh_pool_size / (double)num_islands) - 1;
+        for(unsigned i = 0; i < no_of_individuals; i++) {
+                Individuum ind;
+                island.createIndividuum(config, G, ind, true);
+                island.insert(G, ind);
+        }
+
+        int reps = config.mh_pool_size - no_of_individuals;
+        if(reps < 0) reps = 0;
+
+        // fill the pool with random individuals of the other islands
+        // in every repetition each island sends and receives exactly one individual
+        for( int r = 0; r < reps; r++) {
+                int target = m_island_id;
+                if( num_islands > 1 ) {
+                        target = (m_island_id + 1 + r % (num_islands - 1)) % num_islands;
+                }
+
+                Individuum in;
+                island.get_random_individuum(in);
+
+                int* partition_map = new int[G.number_of_nodes()];
+                in.partition_map->unpack(partition_map);
+                m_mailboxes[target].push(partition_map, m_island_id);
+
+                #pragma omp barrier
+
+                std::vector< island_mailbox::message > messages;
+                m_mailboxes[m_island_id].take_all(messages);
+                for( unsigned i = 0; i < messages.size(); i++) {
+                        Individuum out;
+                        to_individuum(config, G, messages[i].partition_map, out);
+                        island.insert(G, out);
+                }
+        }
+}
+
+//extended push protocol of the exchanger
+void shared_memory_exchanger::push_best( PartitionConfig & config, graph_access & G, population & island ) {
+        Individuum best_ind;
+        island.get_best_individuum(best_ind);
+
+        if( best_ind.objective < m_prev_best_objective) {
+                m_prev_best_objective = best_ind.objective;
+                for( unsigned i = 0; i < m_allready_send_to.size(); i++) {
+                        m_allready_send_to[i] = false;
+                }
+
+                m_allready_send_to[m_island_id] = true;
+                m_cur_num_pushes                = 0;
+        }
+
+        bool something_todo = false;
+        for( unsigned i = 0; i < m_allready_send_to.size(); i++) {
+                if(!m_allready_send_to[i]) {
+                      something_todo = true;
+                      break;
+                }
+        }
+
+        if( m_cur_num_pushes > m_max_num_pushes ) {
+                something_todo = false;
+        }
+
+        if(something_todo) {
+                int* partition_map = new int[G.number_of_nodes()];
+                forall_nodes(G, node) {
+                        partition_map[node] = G.getPartitionIndex(node);
+                } endfor
+
+                int target = m_island_id;
+                while( m_allready_send_to[target] ) {
+                        target = random_functions::nextInt(0, m_mailboxes.size()-1);
+                }
+
+                m_mailboxes[target].push(partition_map, m_island_id);
+                m_cur_num_pushes++;
+
+                m_allready_send_to[target] = true;
+        }
+}
+
+void shared_memory_exchanger::recv_incoming( PartitionConfig & config, graph_access & G, population & island ) {
+        std::vector< island_mailbox::message > messages;
+        m_mailboxes[m_island_id].take_all(messages);
+
+        for( unsigned i = 0; i < messages.size(); i++) {
+                Individuum out;
+                to_individuum(config, G, messages[i].partition_map, out);
+                island.insert( G, out );
+
+                if( (unsigned)out.objective < (unsigned)m_prev_best_objective) {
+                        m_prev_best_objective = out.objective;
+
+                        for( unsigned j = 0; j < m_allready_send_to.size(); j++) {
+                                m_allready_send_to[j] = false;
+                        }
+
+                        m_allready_send_to[m_island_id] = true;
+                        m_cur_num_pushes                = 0;
+                }
+
+                m_allready_send_to[messages[i].sender] = true; // we dont need to send it back
+        }
+}
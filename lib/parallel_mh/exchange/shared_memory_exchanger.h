@@ -0,0 +1,45 @@
+/******************************************************************************
+ * shared_memory_exchanger.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef SHARED_MEMORY_EXCHANGER_B3WN8R1D
+#define SHARED_MEMORY_EXCHANGER_B3WN8R1D
+
+#include "data_structure/graph_access.h"
+#include "island_mailbox.h"
+#include "parallel_mh/population.h"
+#include "partition_config.h"
+#include "tools/quality_metrics.h"
+
+// counterpart of the exchanger for islands that are threads of one process
+// individuals are passed through the mailboxes of the target islands
+class shared_memory_exchanger {
+public:
+        shared_memory_exchanger( std::vector< island_mailbox > & mailboxes, int island_id );
+        virtual ~shared_memory_exchanger();
+
+        // has to be called by all islands (it synchronizes them)
+        void quick_start( PartitionConfig & config,  graph_access & G, population & island );
+        void push_best( PartitionConfig & config,  graph_access & G, population & island );
+        void recv_incoming( PartitionConfig & config,  graph_access & G, population & island );
+
+private:
+        // consumes partition_map
+        void to_individuum( const PartitionConfig & config, graph_access & G, int* partition_map, Individuum & out );
+
+        std::vector< island_mailbox > & m_mailboxes;
+        std::vector<bool>               m_allready_send_to;
+
+        int m_island_id;
+        int m_prev_best_objective;
+        int m_max_num_pushes;
+        int m_cur_num_pushes;
+
+        quality_metrics m_qm;
+};
+
+
+#endif /* end of include guard: SHARED_MEMORY_EXCHANGER_B3WN8R1D */
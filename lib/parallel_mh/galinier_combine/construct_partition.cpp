@@ -138,15 +138,7 @@ void construct_partition::createIndividuum( PartitionConfig & config, graph_acce
 
         quality_metrics qm; 
         ind.objective     = qm.objective(config, G, partition_map);
-        ind.partition_map = partition_map;
-        ind.cut_edges     = new std::vector<EdgeID>();
-
-        forall_nodes(G, node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        if(partition_map[node] != partition_map[target]) {
-                                ind.cut_edges->push_back(e);
-                        }
-                } endfor
-        } endfor
+        ind.partition_map = packed_partition::pack(partition_map, G.number_of_nodes());
+        ind.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
+        delete[] partition_map;
 }
@@ -5,8 +5,10 @@
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <omp.h>
 #include <sstream>
 
 #include "construct_partition.h"
@@ -33,15 +35,10 @@ gal_combine::~gal_combine() {
 // apply our refinements and tabu search
 void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access & G) {
         //first greedily compute a matching of the partitions
-        std::vector< std::unordered_map<PartitionID, unsigned> > counters(config.k);
-        forall_nodes(G, node) {
-                //boundary_pair bp;
-                if(counters[G.getPartitionIndex(node)].find(G.getSecondPartitionIndex(node)) != counters[G.getPartitionIndex(node)].end()) {
-                        counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] += 1;
-                } else {
-                        counters[G.getPartitionIndex(node)][G.getSecondPartitionIndex(node)] = 1;
-                }
-        } endfor
+        std::vector< PartitionID > overlap_block;
+        std::vector< NodeID >      overlap_count;
+        std::vector< NodeID >      first_overlap;
+        count_overlaps( config, G, first_overlap, overlap_block, overlap_count);
 
         std::vector< PartitionID > permutation(config.k);
         for( unsigned i = 0; i < permutation.size(); i++) {
@@ -56,11 +53,12 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
                 PartitionID best_unassigned = config.k;
                 NodeWeight  best_value      = 0;
 
-                for( std::unordered_map<PartitionID, unsigned>::iterator it = counters[cur_partition].begin(); 
-                     it != counters[cur_partition].end(); ++it) {
-                        if( rhs_matched[it->first] == false && it->second > best_value ) {
-                                best_unassigned = it->first; 
-                                best_value = it->second;
+                for( NodeID j = first_overlap[cur_partition]; j < first_overlap[cur_partition+1]; j++) {
+                        if( overlap_count[j] == 0 ) break; // end of the distinct overlaps of this block
+
+                        if( rhs_matched[overlap_block[j]] == false && overlap_count[j] > best_value ) {
+                                best_unassigned = overlap_block[j]; 
+                                best_value      = overlap_count[j];
                         }
                 }
 
@@ -70,15 +68,14 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
                 }
         }
 
-        std::vector<bool> blocked_vertices(G.number_of_nodes(), false);
-        forall_nodes(G, node) {
-                if( bipartite_matching[G.getPartitionIndex(node)] == G.getSecondPartitionIndex(node) ){
-                        blocked_vertices[node] = true;
-                } else {
-                        // we will reassign this vertex since the partitions do not agree on it
+        // we will reassign the vertices on which the partitions do not agree
+        int n = G.number_of_nodes();
+        #pragma omp parallel for num_threads(config.num_threads) schedule(static)
+        for( int node = 0; node < n; node++) {
+                if( bipartite_matching[G.getPartitionIndex(node)] != G.getSecondPartitionIndex(node) ){
                         G.setPartitionIndex(node, config.k); 
                 }
-        } endfor
+        }
 
         construct_partition cp;
         cp.construct_starting_from_partition( config, G );
@@ -112,3 +109,62 @@ void gal_combine::perform_gal_combine( PartitionConfig & config, graph_access &
 
         
 }
+
+// counts the nodes of every pair (block of the first, block of the second partition).
+// the second blocks are bucketed by their first block (counting sort), then every bucket
+// is reduced with a dense counter array. the distinct overlaps of block a are stored in
+// [first_overlap[a], first_overlap[a+1]) sorted by block, unused entries have count zero
+void gal_combine::count_overlaps( PartitionConfig & config, graph_access & G, 
+                                  std::vector< NodeID > & first_overlap,
+                                  std::vector< PartitionID > & overlap_block,
+                                  std::vector< NodeID > & overlap_count) {
+        int n = G.number_of_nodes();
+        int k = config.k;
+
+        first_overlap.assign(k+1, 0);
+        #pragma omp parallel for num_threads(config.num_threads) schedule(static)
+        for( int node = 0; node < n; node++) {
+                #pragma omp atomic
+                first_overlap[G.getPartitionIndex(node)+1]++;
+        }
+
+        for( int block = 0; block < k; block++) {
+                first_overlap[block+1] += first_overlap[block];
+        }
+
+        std::vector< NodeID > insert_pos(first_overlap.begin(), first_overlap.end()-1);
+        std::vector< PartitionID > seconds(n);
+        #pragma omp parallel for num_threads(config.num_threads) schedule(static)
+        for( int node = 0; node < n; node++) {
+                NodeID pos;
+                #pragma omp atomic capture
+                pos = insert_pos[G.getPartitionIndex(node)]++;
+                seconds[pos] = G.getSecondPartitionIndex(node);
+        }
+
+        overlap_block.assign(n, 0);
+        overlap_count.assign(n, 0);
+        #pragma omp parallel num_threads(config.num_threads)
+        {
+                std::vector< NodeID > counter(k, 0);
+                std::vector< PartitionID > touched;
+
+                #pragma omp for schedule(dynamic, 16)
+                for( int block = 0; block < k; block++) {
+                        touched.clear();
+                        for( NodeID i = first_overlap[block]; i < first_overlap[block+1]; i++) {
+                                if( counter[seconds[i]]++ == 0 ) {
+                                        touched.push_back(seconds[i]);
+                                }
+                        }
+
+                        std::sort(touched.begin(), touched.end());
+                        NodeID pos = first_overlap[block];
+                        for( unsigned i = 0; i < touched.size(); i++, pos++) {
+                                overlap_block[pos] = touched[i];
+                                overlap_count[pos] = counter[touched[i]];
+                                counter[touched[i]] = 0;
+                        }
+                }
+        }
+}
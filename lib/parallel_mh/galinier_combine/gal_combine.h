@@ -17,6 +17,12 @@ public:
         virtual ~gal_combine();
 
         void perform_gal_combine( PartitionConfig & config, graph_access & G);
+
+private:
+        void count_overlaps( PartitionConfig & config, graph_access & G, 
+                             std::vector< NodeID > & first_overlap,
+                             std::vector< PartitionID > & overlap_block,
+                             std::vector< NodeID > & overlap_count);
 };
 
 
@@ -9,6 +9,7 @@
 #include <fstream>
 #include <iostream>
 #include <mpi.h>
+#include <omp.h>
 #include <sstream>
 #include <stdio.h>
 
@@ -17,6 +18,7 @@
 #include "galinier_combine/construct_partition.h"
 #include "graph_io.h"
 #include "graph_partitioner.h"
+#include "memory_budget.h"
 #include "parallel_mh_async.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
@@ -44,6 +46,9 @@ parallel_mh_async::parallel_mh_async(MPI_Comm communicator) : MASTER(0), m_time_
 
 parallel_mh_async::~parallel_mh_async() {
         delete[] m_best_global_map;
+        for( unsigned i = 0; i < m_worker_graphs.size(); i++) {
+                delete m_worker_graphs[i];
+        }
 }
 
 void parallel_mh_async::perform_partitioning(const PartitionConfig & partition_config, graph_access & G) {
@@ -151,6 +156,10 @@ void parallel_mh_async::initialize(PartitionConfig & working_config, graph_acces
         } else {
                 population_size = std::min(100, population_size);
         }
+        if( working_config.memory_budget > 0 ) {
+                unsigned affordable = memory_budget::affordable_individuals(working_config, G, m_island->memory(), 1);
+                population_size     = std::max(3, (int)std::min((unsigned)population_size, affordable));
+        }
         std::cout <<  "poolsize = " <<  population_size  << std::endl;
 
         //set S
@@ -227,96 +236,169 @@ EdgeWeight parallel_mh_async::perform_local_partitioning(PartitionConfig & worki
                 div.diversify(working_config);
         }
 
-        //start a new round
-        for( unsigned i = 0; i < local_repetitions; i++) {
-                if( working_config.mh_no_mh ) {
-                        Individuum first_ind;
+        if( working_config.mh_pipeline_workers > 1 ) {
+                perform_pipelined_partitioning( working_config, G );
+        } else {
+                //start a new round
+                for( unsigned i = 0; i < local_repetitions; i++) {
+                        perform_evolutionary_step( working_config, G, *m_island );
 
-                        if( !working_config.mh_easy_construction) {
-                                m_island->createIndividuum(working_config, G, first_ind, true);
-                                m_island->insert(G, first_ind);
-                        } else {
-                                construct_partition cp;
-                                cp.createIndividuum( working_config, G, first_ind, true); 
+                        //try to combine to random inidividuals from pool 
+                        if( m_t.elapsed() > m_time_limit ) {
+                                break;
+                        }
+
+                }
+        }
+
+        EdgeWeight min_objective = 0;
+        m_island->apply_fittest(G, min_objective);
+
+        return min_objective;
+}
 
-                                m_island->insert(G, first_ind);
-                                std::cout <<  "created with objective " <<  first_ind.objective << std::endl;
+void parallel_mh_async::perform_pipelined_partitioning(PartitionConfig & working_config, graph_access & G) {
+        // every worker repeatedly selects parents, computes an offspring on its own
+        // view of the graph and inserts it; only selection and insertion lock the island
+        int num_workers = working_config.mh_pipeline_workers;
+        if( m_worker_graphs.size() != (unsigned)num_workers ) {
+                for( unsigned i = 0; i < m_worker_graphs.size(); i++) {
+                        delete m_worker_graphs[i];
+                }
+                m_worker_graphs.assign(num_workers, NULL);
+                for( int i = 1; i < num_workers; i++) {
+                        m_worker_graphs[i] = new graph_access();
+                        m_worker_graphs[i]->share_graph(G);
+                }
+        }
+
+        std::vector<int> seeds(num_workers);
+        for( int i = 0; i < num_workers; i++) {
+                seeds[i] = random_functions::nextInt(0, std::numeric_limits<int>::max());
+        }
+        int continuation_seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+
+        unsigned offspring = std::max(working_config.local_partitioning_repetitions, (unsigned)num_workers);
+        unsigned next      = 0;
+
+        // the workers share std::cout
+        bool redirect = !omp_in_parallel();
+        std::ofstream ofs;
+        std::streambuf* backup = std::cout.rdbuf();
+        if( redirect ) {
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf());
+        }
+
+        #pragma omp parallel num_threads(num_workers)
+        {
+                int id = omp_get_thread_num();
+                graph_access & WG = id == 0 ? G : *m_worker_graphs[id];
+                WG.set_partition_count(G.get_partition_count());
+                random_functions::setSeed(seeds[id]);
+
+                PartitionConfig worker_config      = working_config;
+                // keeps the private state of a view at its partition between coarsenings
+                worker_config.release_edge_ratings = true;
+                while( true ) {
+                        unsigned current;
+                        #pragma omp atomic capture
+                        current = next++;
+
+                        if( current >= offspring || m_t.elapsed() > m_time_limit ) {
+                                break;
                         }
+
+                        perform_evolutionary_step( worker_config, WG, *m_island );
+                }
+        }
+
+        if( redirect ) {
+                ofs.close();
+                std::cout.rdbuf(backup);
+        }
+        random_functions::setSeed(continuation_seed);
+}
+
+void parallel_mh_async::perform_evolutionary_step(PartitionConfig & working_config, graph_access & G, population & island) {
+        if( working_config.mh_no_mh ) {
+                Individuum first_ind;
+
+                if( !working_config.mh_easy_construction) {
+                        island.createIndividuum(working_config, G, first_ind, true);
+                        island.insert(G, first_ind);
                 } else {
-                        if( m_island->is_full() && !working_config.mh_disable_combine) {
+                        construct_partition cp;
+                        cp.createIndividuum( working_config, G, first_ind, true); 
 
-                                int decision = random_functions::nextInt(0,9);
-                                Individuum output;
+                        island.insert(G, first_ind);
+                        std::cout <<  "created with objective " <<  first_ind.objective << std::endl;
+                }
+        } else {
+                if( island.is_full() && !working_config.mh_disable_combine) {
 
-                                if(decision < working_config.mh_flip_coin) {
-                                        m_island->mutate_random(working_config, G, output);
-                                        m_island->insert(G, output);
-                                } else {
+                        int decision = random_functions::nextInt(0,9);
+                        Individuum output;
 
-                                        int combine_decision = random_functions::nextInt(0,5);
-                                        if(combine_decision <= 4) {
-                                                Individuum first_rnd;
-                                                Individuum second_rnd;
-                                                if(working_config.mh_enable_tournament_selection) {
-                                                        m_island->get_two_individuals_tournament(first_rnd, second_rnd);
-                                                } else {
-                                                        m_island->get_two_random_individuals(first_rnd, second_rnd);
-                                                }
+                        if(decision < working_config.mh_flip_coin) {
+                                island.mutate_random(working_config, G, output);
+                                island.insert(G, output);
+                        } else {
 
-                                                m_island->combine(working_config, G, first_rnd, second_rnd, output);
+                                int combine_decision = random_functions::nextInt(0,5);
+                                if(combine_decision <= 4) {
+                                        Individuum first_rnd;
+                                        Individuum second_rnd;
+                                        if(working_config.mh_enable_tournament_selection) {
+                                                island.get_two_individuals_tournament(first_rnd, second_rnd);
+                                        } else {
+                                                island.get_two_random_individuals(first_rnd, second_rnd);
+                                        }
 
-                                                int coin = 0;
+                                        island.combine(working_config, G, first_rnd, second_rnd, output);
 
-                                                if( working_config.mh_enable_gal_combine ) {
-                                                        coin = random_functions::nextInt(0,100);
-                                                }
-                                                if( coin == 23 ) {
-                                                        if( first_rnd.objective > second_rnd.objective) {
-                                                                m_island->replace(first_rnd, output);
-                                                        } else {
-                                                                m_island->replace(second_rnd, output);
-                                                        }
+                                        int coin = 0;
+
+                                        if( working_config.mh_enable_gal_combine ) {
+                                                coin = random_functions::nextInt(0,100);
+                                        }
+                                        if( coin == 23 ) {
+                                                bool replaced = false;
+                                                if( first_rnd.objective > second_rnd.objective) {
+                                                        replaced = island.replace(first_rnd, output);
                                                 } else {
-                                                        m_island->insert(G, output);
+                                                        replaced = island.replace(second_rnd, output);
                                                 }
-                                        } else if( combine_decision == 5 ) {
-                                                if(!working_config.mh_disable_cross_combine) {
-                                                        Individuum selected;
-                                                        m_island->get_one_individual_tournament(selected);
-                                                        m_island->combine_cross(working_config, G, selected, output);
-                                                        m_island->insert(G, output);
+                                                if( !replaced ) { // removed by a concurrent pipeline worker
+                                                        island.insert(G, output);
                                                 }
+                                        } else {
+                                                island.insert(G, output);
+                                        }
+                                } else if( combine_decision == 5 ) {
+                                        if(!working_config.mh_disable_cross_combine) {
+                                                Individuum selected;
+                                                island.get_one_individual_tournament(selected);
+                                                island.combine_cross(working_config, G, selected, output);
+                                                island.insert(G, output);
                                         }
                                 }
+                        }
 
+                } else {
+                        Individuum first_ind;
+                        if(island.is_full()) {
+                                island.mutate_random(working_config, G, first_ind);
                         } else {
-                                Individuum first_ind;
-                                if(m_island->is_full()) {
-                                        m_island->mutate_random(working_config, G, first_ind);
+                                if( !working_config.mh_easy_construction) {
+                                        island.createIndividuum(working_config, G, first_ind, true);
                                 } else {
-                                        if( !working_config.mh_easy_construction) {
-                                                m_island->createIndividuum(working_config, G, first_ind, true);
-                                        } else {
-                                                construct_partition cp;
-                                                cp.createIndividuum( working_config, G, first_ind, true); 
-                                                std::cout <<  "created with objective " <<  first_ind.objective << std::endl;
-                                        }
+                                        construct_partition cp;
+                                        cp.createIndividuum( working_config, G, first_ind, true); 
+                                        std::cout <<  "created with objective " <<  first_ind.objective << std::endl;
                                 }
-                                m_island->insert(G, first_ind);
                         }
+                        island.insert(G, first_ind);
                 }
-
-                //try to combine to random inidividuals from pool 
-                if( m_t.elapsed() > m_time_limit ) {
-                        break;
-                }
-
         }
-
-        EdgeWeight min_objective = 0;
-        m_island->apply_fittest(G, min_objective);
-
-        return min_objective;
 }
-
-
@@ -26,7 +26,13 @@ public:
         EdgeWeight collect_best_partitioning(graph_access & G, const PartitionConfig & config);
         void perform_cycle_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G);
 
+        // one create, mutate or combine operation on the island (does not communicate)
+        static void perform_evolutionary_step(PartitionConfig & graph_partitioner_config, graph_access & G, population & island);
+
 private:
+        // computes the offspring of a round with config.mh_pipeline_workers threads
+        void perform_pipelined_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G);
+
         //misc
         const unsigned MASTER;
         timer    m_t;
@@ -44,6 +50,9 @@ private:
         //island
         population* m_island;
         MPI_Comm m_communicator;
+
+        //views of the input graph used by the pipeline workers (worker 0 uses the input graph)
+        std::vector< graph_access* > m_worker_graphs;
 };
 
 
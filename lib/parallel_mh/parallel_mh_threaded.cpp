@@ -0,0 +1,220 @@
+/******************************************************************************
+ * parallel_mh_threaded.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <math.h>
+#include <omp.h>
+#include <sstream>
+
+#include "diversifyer.h"
+#include "exchange/shared_memory_exchanger.h"
+#include "galinier_combine/construct_partition.h"
+#include "memory_budget.h"
+#include "parallel_mh_async.h"
+#include "parallel_mh_threaded.h"
+#include "random_functions.h"
+
+parallel_mh_threaded::parallel_mh_threaded() : m_time_limit(0), m_num_islands(1), m_population_size(3), m_mailboxes(NULL) {
+}
+
+parallel_mh_threaded::~parallel_mh_threaded() {
+        delete m_mailboxes;
+}
+
+void parallel_mh_threaded::perform_partitioning(const PartitionConfig & partition_config, graph_access & G) {
+        m_time_limit = partition_config.time_limit;
+
+        // the islands share std::cout, hence it is redirected once for all of them
+        std::ofstream ofs;
+        std::streambuf* backup = std::cout.rdbuf();
+        ofs.open("/dev/null");
+        std::cout.rdbuf(ofs.rdbuf());
+
+        #pragma omp parallel num_threads(partition_config.num_threads)
+        {
+                #pragma omp single
+                {
+                        m_num_islands = omp_get_num_threads();
+                        m_mailboxes   = new std::vector< island_mailbox >(m_num_islands);
+                        m_island_maps.resize(m_num_islands);
+                        m_island_objective.resize(m_num_islands);
+                        m_island_max_block_weight.resize(m_num_islands);
+                }
+
+                run_island(partition_config, G, omp_get_thread_num());
+        }
+
+        ofs.close();
+        std::cout.rdbuf(backup);
+
+        // feasible partitions first, then objective, then balance
+        int best = 0;
+        for( int i = 0; i < m_num_islands; i++) {
+                std::cout <<  "island " <<  i <<  " objective " <<  m_island_objective[i] << std::endl;
+
+                bool feasible      = m_island_max_block_weight[i]    <= partition_config.upper_bound_partition;
+                bool best_feasible = m_island_max_block_weight[best] <= partition_config.upper_bound_partition;
+                if( feasible != best_feasible ) {
+                        if( feasible ) best = i;
+                        continue;
+                }
+
+                if( m_island_objective[i] < m_island_objective[best]
+                 || (m_island_objective[i] == m_island_objective[best]
+                     && m_island_max_block_weight[i] < m_island_max_block_weight[best])) {
+                        best = i;
+                }
+        }
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, m_island_maps[best][node]);
+        } endfor
+
+        delete m_mailboxes;
+        m_mailboxes = NULL;
+}
+
+void parallel_mh_threaded::run_island(const PartitionConfig & partition_config, graph_access & G, int island_id) {
+        // island 0 works on the input graph, the other islands on views of it with a private partition.
+        // the views have to take the input partition before island 0 modifies it
+        graph_access* island_graph = &G;
+        if( island_id != ROOT ) {
+                island_graph = new graph_access();
+                island_graph->share_graph(G);
+        }
+        #pragma omp barrier
+
+        random_functions::setSeed(partition_config.seed*m_num_islands+island_id);
+
+        PartitionConfig ini_working_config      = partition_config;
+        ini_working_config.num_threads          = 1;
+        // the edge ratings are only needed during the contraction of a level, without them the
+        // private state of an island is its partition
+        ini_working_config.release_edge_ratings = true;
+        population island(ini_working_config, island_id);
+        initialize( ini_working_config, *island_graph, island, island_id);
+
+        #pragma omp single
+        m_t.restart();
+
+        shared_memory_exchanger ex(*m_mailboxes, island_id);
+        unsigned rounds = 0;
+        do {
+                PartitionConfig working_config  = ini_working_config;
+
+                working_config.graph_allready_partitioned  = false;
+                if(!partition_config.strong)
+                        working_config.no_new_initial_partitioning = false;
+
+                if(rounds == 0 && working_config.mh_enable_quickstart) {
+                        ex.quick_start( working_config, *island_graph, island );
+                }
+
+                perform_local_partitioning( working_config, *island_graph, island );
+
+                //push and recv
+                if( m_t.elapsed() <= m_time_limit && m_num_islands > 1) {
+                        unsigned messages = ceil(log(m_num_islands));
+                        for( unsigned i = 0; i < messages; i++) {
+                                ex.push_best( working_config, *island_graph, island );
+                                ex.recv_incoming( working_config, *island_graph, island );
+                        }
+                }
+
+                rounds++;
+        } while( m_t.elapsed() <= m_time_limit );
+
+        collect_best_partitioning(*island_graph, partition_config, island, island_id);
+
+        if( island_id != ROOT ) {
+                delete island_graph;
+        }
+}
+
+void parallel_mh_threaded::initialize(PartitionConfig & working_config, graph_access & G, population & island, int island_id) {
+        // estimate the runtime of a partitioner call on island 0
+        // and derive the pool size of all islands from it
+        Individuum first_one;
+        timer t;
+        if( !working_config.mh_easy_construction) {
+                island.createIndividuum( working_config, G, first_one, true);
+        } else {
+                construct_partition cp;
+                cp.createIndividuum( working_config, G, first_one, true);
+        }
+
+        double time_spend = t.elapsed();
+        island.insert(G, first_one);
+
+        if( island_id == ROOT ) {
+                double fraction_to_spend_for_IP = (double)m_time_limit / working_config.mh_initial_population_fraction;
+                int population_size             = ceil(fraction_to_spend_for_IP / time_spend);
+
+                population_size = std::max(3, population_size);
+                if(working_config.mh_easy_construction) {
+                        population_size = std::min(50, population_size);
+                } else {
+                        population_size = std::min(100, population_size);
+                }
+                if( working_config.memory_budget > 0 ) {
+                        // the islands share the budget of the process
+                        unsigned affordable = memory_budget::affordable_individuals(working_config, G, island.memory(), m_num_islands);
+                        population_size     = std::max(3, (int)std::min((unsigned)population_size, affordable));
+                }
+                m_population_size = population_size;
+        }
+        #pragma omp barrier
+
+        island.set_pool_size(m_population_size);
+        working_config.mh_pool_size = m_population_size;
+}
+
+EdgeWeight parallel_mh_threaded::perform_local_partitioning(PartitionConfig & working_config, graph_access & G, population & island) {
+        unsigned local_repetitions = working_config.local_partitioning_repetitions;
+
+        if( working_config.mh_diversify ) {
+                diversifyer div;
+                div.diversify(working_config);
+        }
+
+        for( unsigned i = 0; i < local_repetitions; i++) {
+                parallel_mh_async::perform_evolutionary_step( working_config, G, island );
+
+                if( m_t.elapsed() > m_time_limit ) {
+                        break;
+                }
+        }
+
+        EdgeWeight min_objective = 0;
+        island.apply_fittest(G, min_objective);
+
+        return min_objective;
+}
+
+void parallel_mh_threaded::collect_best_partitioning(graph_access & G, const PartitionConfig & config, population & island, int island_id) {
+        EdgeWeight min_objective = 0;
+        island.apply_fittest(G, min_objective);
+
+        std::vector< PartitionID > & map = m_island_maps[island_id];
+        std::vector< NodeWeight > block_weights(G.get_partition_count(), 0);
+        map.resize(G.number_of_nodes());
+
+        forall_nodes(G, node) {
+                map[node] = G.getPartitionIndex(node);
+                block_weights[map[node]] += G.getNodeWeight(node);
+        } endfor
+
+        NodeWeight max_block_weight = 0;
+        for( unsigned i = 0; i < block_weights.size(); i++) {
+                max_block_weight = std::max(max_block_weight, block_weights[i]);
+        }
+
+        m_island_objective[island_id]        = min_objective;
+        m_island_max_block_weight[island_id] = max_block_weight;
+}
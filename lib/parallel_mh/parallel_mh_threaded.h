@@ -0,0 +1,48 @@
+/******************************************************************************
+ * parallel_mh_threaded.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARALLEL_MH_THREADED_K5T0XQ2C
+#define PARALLEL_MH_THREADED_K5T0XQ2C
+
+#include "data_structure/graph_access.h"
+#include "exchange/island_mailbox.h"
+#include "partition_config.h"
+#include "population.h"
+#include "timer.h"
+
+// evolutionary algorithm in which the islands are threads of one process
+// (config.num_threads islands) instead of MPI ranks.
+// the input graph is read once and shared: island 0 works on it, every further island
+// on a view (graph_access::share_graph) that only owns its partition and edge ratings
+class parallel_mh_threaded {
+public:
+        parallel_mh_threaded();
+        virtual ~parallel_mh_threaded();
+
+        void perform_partitioning(const PartitionConfig & graph_partitioner_config, graph_access & G);
+
+private:
+        void run_island(const PartitionConfig & graph_partitioner_config, graph_access & G, int island_id);
+        void initialize(PartitionConfig & graph_partitioner_config, graph_access & G, population & island, int island_id);
+        EdgeWeight perform_local_partitioning(PartitionConfig & graph_partitioner_config, graph_access & G, population & island);
+        void collect_best_partitioning(graph_access & G, const PartitionConfig & config, population & island, int island_id);
+
+        timer    m_t;
+        double   m_time_limit;
+        int      m_num_islands;
+        int      m_population_size;
+
+        std::vector< island_mailbox >* m_mailboxes;
+
+        //best partition of every island with its objective and max block weight
+        std::vector< std::vector< PartitionID > > m_island_maps;
+        std::vector< EdgeWeight >                 m_island_objective;
+        std::vector< NodeWeight >                 m_island_max_block_weight;
+};
+
+
+#endif /* end of include guard: PARALLEL_MH_THREADED_K5T0XQ2C */
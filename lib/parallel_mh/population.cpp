@@ -10,6 +10,7 @@
 #include <iostream>
 #include <math.h>
 #include <mpi.h>
+#include <omp.h>
 #include <sstream>
 
 #include "diversifyer.h"
@@ -28,40 +29,63 @@ population::population( MPI_Comm communicator, const PartitionConfig & partition
         m_num_NCs_computed   = 0;
         m_num_ENCs           = 0;
         m_time_stamp         = 0;
+        m_island_id          = 0;
         m_communicator       = communicator;
         m_global_timer.restart();
 }
 
+population::population( const PartitionConfig & partition_config, int island_id ) {
+        m_population_size    = partition_config.mh_pool_size;
+        m_no_partition_calls = 0;
+        m_num_NCs            = partition_config.mh_num_ncs_to_compute;
+        m_num_NCs_computed   = 0;
+        m_num_ENCs           = 0;
+        m_time_stamp         = 0;
+        m_island_id          = island_id;
+        m_communicator       = MPI_COMM_NULL;
+        m_global_timer.restart();
+}
+
 population::~population() {
-        for( unsigned i = 0; i < m_internal_population.size(); i++) {
-                delete[] (m_internal_population[i].partition_map);
-                delete m_internal_population[i].cut_edges;
-        }         
 }
 
 void population::set_pool_size(int size) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         m_population_size = size;
 }
 
 void population::createIndividuum(const PartitionConfig & config, 
                                   graph_access & G, 
 			          Individuum & ind, bool output) {
+        createIndividuum(config, G, ind, output, packed_partition_ptr());
+}
+
+void population::createIndividuum(const PartitionConfig & config, 
+                                  graph_access & G, 
+			          Individuum & ind, bool output,
+                                  const packed_partition_ptr & parent) {
 
         PartitionConfig copy = config;
         graph_partitioner partitioner;
         quality_metrics qm;
 
+        // islands running as threads redirect the output once for all of them
+        bool redirect = !omp_in_parallel();
         std::ofstream ofs;
         std::streambuf* backup = std::cout.rdbuf();
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
+        if( redirect ) {
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
 
         timer t; t.restart();
 
         if(config.buffoon) { // graph is weighted -> no negative cycle detection yet
                 partitioner.perform_partitioning(copy, G);
-                ofs.close();
-                std::cout.rdbuf(backup);
+                if( redirect ) {
+                        ofs.close();
+                        std::cout.rdbuf(backup);
+                }
         } else {
                 if(config.kabapE) {
                         double real_epsilon        = config.imbalance/100.0;
@@ -72,8 +96,10 @@ void population::createIndividuum(const PartitionConfig & config,
 
                         partitioner.perform_partitioning(copy, G);
 
-                        ofs.close();
-                        std::cout.rdbuf(backup);
+                        if( redirect ) {
+                                ofs.close();
+                                std::cout.rdbuf(backup);
+                        }
 
                         complete_boundary boundary(&G);
                         boundary.build();
@@ -87,8 +113,10 @@ void population::createIndividuum(const PartitionConfig & config,
                         cr.perform_refinement(copy, G, boundary);
                 } else {
                         partitioner.perform_partitioning(copy, G);
-                        ofs.close();
-                        std::cout.rdbuf(backup);
+                        if( redirect ) {
+                                ofs.close();
+                                std::cout.rdbuf(backup);
+                        }
                 }
         }
 
@@ -99,25 +127,19 @@ void population::createIndividuum(const PartitionConfig & config,
         } endfor
 
         ind.objective     = qm.objective(config, G, partition_map);
-        ind.partition_map = partition_map;
-        ind.cut_edges     = new std::vector<EdgeID>();
-
-        forall_nodes(G, node) {
-                forall_out_edges(G, e, node) {
-                        NodeID target = G.getEdgeTarget(e);
-                        if(partition_map[node] != partition_map[target]) {
-                                ind.cut_edges->push_back(e);
-                        }
-                } endfor
-        } endfor
+        ind.partition_map = packed_partition::pack(partition_map, G.number_of_nodes(), parent);
+        ind.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
+        delete[] partition_map;
 
         if(output) {
+                 std::lock_guard< std::mutex > guard(m_mutex);
                  m_filebuffer_string <<  m_global_timer.elapsed() <<  " " <<  ind.cut_edges->size()/2 <<  std::endl;
                  m_time_stamp++;
         }
 }
 
 void population::insert(graph_access & G, Individuum & ind) {
+        std::lock_guard< std::mutex > guard(m_mutex);
 
         m_no_partition_calls++;
         if(m_internal_population.size() < m_population_size) {
@@ -130,8 +152,6 @@ void population::insert(graph_access & G, Individuum & ind) {
                         }
                 }         
                 if(ind.objective > worst_objective ) {
-                        delete[] (ind.partition_map);
-                        delete ind.cut_edges;
                         return; // do nothing
                 }
                 //else measure similarity
@@ -140,23 +160,8 @@ void population::insert(graph_access & G, Individuum & ind) {
                 for( unsigned i = 0; i < m_internal_population.size(); i++) {
                         if(m_internal_population[i].objective >= ind.objective) {
                                 //now measure
-				int diff_size = m_internal_population[i].cut_edges->size() + ind.cut_edges->size();
-                                std::vector<EdgeID> output_diff(diff_size,std::numeric_limits<EdgeID>::max());
-
-                                set_symmetric_difference(m_internal_population[i].cut_edges->begin(),
-                                                         m_internal_population[i].cut_edges->end(),
-                                                         ind.cut_edges->begin(),
-                                                         ind.cut_edges->end(),
-                                                         output_diff.begin());
-
-                                unsigned similarity = 0;
-                                for( unsigned j = 0; j < output_diff.size(); j++) {
-                                        if(output_diff[j] < std::numeric_limits<EdgeID>::max()) {
-                                                similarity++;
-                                        } else {
-                                                break;
-                                        }
-                                }
+                                unsigned similarity = packed_edge_set::symmetric_difference_size(*m_internal_population[i].cut_edges,
+                                                                                                 *ind.cut_edges);
 
                                 if( similarity < max_similarity) {
                                         max_similarity     = similarity;
@@ -165,25 +170,22 @@ void population::insert(graph_access & G, Individuum & ind) {
                         }
                 }         
 
-                delete[] (m_internal_population[max_similarity_idx].partition_map);
-                delete m_internal_population[max_similarity_idx].cut_edges;
-
                 m_internal_population[max_similarity_idx] = ind;
         }
 }
 
-void population::replace(Individuum & in, Individuum & out) {
+bool population::replace(Individuum & in, Individuum & out) {
+        std::lock_guard< std::mutex > guard(m_mutex);
+
         //first find it:
         for( unsigned i = 0; i < m_internal_population.size(); i++) {
                 if(m_internal_population[i].partition_map == in.partition_map) {
                         //found it
-                        delete[] (m_internal_population[i].partition_map);
-                        delete m_internal_population[i].cut_edges;
-
                         m_internal_population[i] = out;
-                        break;
+                        return true;
                 }
         }
+        return false;
 }
 
 void population::combine(const PartitionConfig & partition_config, 
@@ -194,17 +196,17 @@ void population::combine(const PartitionConfig & partition_config,
 
         PartitionConfig config = partition_config;
         G.resizeSecondPartitionIndex(G.number_of_nodes());
-        if( first_ind.objective < second_ind.objective ) {
-                forall_nodes(G, node) {
-                        G.setPartitionIndex(node, first_ind.partition_map[node]);
-                        G.setSecondPartitionIndex(node, second_ind.partition_map[node]);
 
-                } endfor
+        // the child is stored relative to the better parent
+        packed_partition_ptr parent;
+        if( first_ind.objective < second_ind.objective ) {
+                first_ind.partition_map->apply(G);
+                second_ind.partition_map->apply_second(G);
+                parent = first_ind.partition_map;
         } else {
-                forall_nodes(G, node) {
-                        G.setPartitionIndex(node, second_ind.partition_map[node]);
-                        G.setSecondPartitionIndex(node, first_ind.partition_map[node]);
-                } endfor
+                second_ind.partition_map->apply(G);
+                first_ind.partition_map->apply_second(G);
+                parent = second_ind.partition_map;
         }
 
         config.combine                     = true;
@@ -227,19 +229,11 @@ void population::combine(const PartitionConfig & partition_config,
 
 		quality_metrics qm;
 		output_ind.objective     = qm.objective(config, G, partition_map);
-		output_ind.partition_map = partition_map;
-		output_ind.cut_edges     = new std::vector<EdgeID>();
-
-		forall_nodes(G, node) {
-			forall_out_edges(G, e, node) {
-				NodeID target = G.getEdgeTarget(e);
-				if(partition_map[node] != partition_map[target]) {
-					output_ind.cut_edges->push_back(e);
-				}
-			} endfor
-		} endfor
+		output_ind.partition_map = packed_partition::pack(partition_map, G.number_of_nodes(), parent);
+		output_ind.cut_edges     = packed_edge_set::cut_edges(G, partition_map);
+		delete[] partition_map;
 	} else {
-	        createIndividuum(config, G, output_ind, true);
+	        createIndividuum(config, G, output_ind, true, parent);
 	}
         std::cout <<  "objective mh " <<  output_ind.objective << std::endl;
 }
@@ -257,7 +251,9 @@ void population::combine_cross(const PartitionConfig & partition_config,
         int kfactor    = random_functions::nextInt(lowerbound,4*config.k);
         kfactor = std::min( kfactor, (int)G.number_of_nodes());
 
-        if( config.mh_cross_combine_original_k ) {
+        // the broadcast is a collective of the main threads of all ranks, parse_parameters
+        // disables concurrent offspring workers (mh_pipeline_workers) if k is broadcasted
+        if( config.mh_cross_combine_original_k && m_communicator != MPI_COMM_NULL && !omp_in_parallel() ) {
                 MPI_Bcast(&kfactor, 1, MPI_INT, 0, m_communicator);
         }
 
@@ -273,27 +269,32 @@ void population::combine_cross(const PartitionConfig & partition_config,
         cross_config.combine                              = false;
         cross_config.graph_allready_partitioned           = false;
 
+        bool redirect = !omp_in_parallel();
 	std::ofstream ofs;
 	std::streambuf* backup = std::cout.rdbuf();
-        ofs.open("/dev/null");
-        std::cout.rdbuf(ofs.rdbuf()); 
+        if( redirect ) {
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
 
         graph_partitioner partitioner;
         partitioner.perform_partitioning(cross_config, G);
 
-        ofs.close();
-        std::cout.rdbuf(backup);
+        if( redirect ) {
+                ofs.close();
+                std::cout.rdbuf(backup);
+        }
 
         forall_nodes(G, node) {
                 G.setSecondPartitionIndex(node, G.getPartitionIndex(node));
-                G.setPartitionIndex(node, first_ind.partition_map[node]);
         } endfor
+        first_ind.partition_map->apply(G);
 
         config.combine                     = true;
         config.graph_allready_partitioned  = true;
         config.no_new_initial_partitioning = true;
 
-        createIndividuum(config, G, output_ind, true);
+        createIndividuum(config, G, output_ind, true, first_ind.partition_map);
         std::cout << "objective cross " << output_ind.objective
                   << " k "              << kfactor
                   << " imbal "          << larger_imbalance
@@ -308,36 +309,30 @@ void population::mutate_random( const PartitionConfig & partition_config, graph_
         config.combine                    = false;
         config.graph_allready_partitioned = true;
         get_random_individuum(first_ind);
+        packed_partition_ptr parent = first_ind.partition_map;
 
         if(number < 5) {
-                forall_nodes(G, node) {
-                        G.setPartitionIndex(node, first_ind.partition_map[node]);
-                } endfor
+                parent->apply(G);
 
                 config.no_new_initial_partitioning = true;
-                createIndividuum( config, G, first_ind, true);
+                createIndividuum( config, G, first_ind, true, parent);
 
         } else {
-                forall_nodes(G, node) {
-                        G.setPartitionIndex(node, first_ind.partition_map[node]);
-                } endfor
+                parent->apply(G);
 
                 config.graph_allready_partitioned  = false;
-                createIndividuum( config, G, first_ind, true);
+                createIndividuum( config, G, first_ind, true, parent);
         }
 }
 
 void population::extinction( ) {
-        for( unsigned i = 0; i < m_internal_population.size(); i++) {
-                delete[] m_internal_population[i].partition_map;
-                delete m_internal_population[i].cut_edges; 
-        }
-
+        std::lock_guard< std::mutex > guard(m_mutex);
         m_internal_population.clear();
         m_internal_population.resize(0);
 }
 
 void population::get_two_random_individuals(Individuum & first, Individuum & second) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         int first_idx = random_functions::nextInt(0, m_internal_population.size()-1);
         first = m_internal_population[first_idx];
 
@@ -369,11 +364,13 @@ void population::get_two_individuals_tournament(Individuum & first, Individuum &
 }
 
 void population::get_random_individuum(Individuum & ind) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         int idx = random_functions::nextInt(0, m_internal_population.size()-1);
         ind     = m_internal_population[idx];
 }
 
 void population::get_best_individuum(Individuum & ind) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         EdgeWeight min_objective = std::numeric_limits<EdgeWeight>::max();
         unsigned idx             = 0;
 
@@ -388,19 +385,19 @@ void population::get_best_individuum(Individuum & ind) {
 }
 
 bool population::is_full() {
+        std::lock_guard< std::mutex > guard(m_mutex);
         return m_internal_population.size() == m_population_size;
 }
 
 void population::apply_fittest( graph_access & G, EdgeWeight & objective ) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         EdgeWeight min_objective = std::numeric_limits<EdgeWeight>::max();
 	double best_balance      = std::numeric_limits<EdgeWeight>::max();
         unsigned idx             = 0;
 
 	quality_metrics qm;
         for( unsigned i = 0; i < m_internal_population.size(); i++) {
-		forall_nodes(G, node) {
-			G.setPartitionIndex(node, m_internal_population[i].partition_map[node]);
-		} endfor
+		m_internal_population[i].partition_map->apply(G);
 		double cur_balance = qm.balance(G);
                 if((EdgeWeight)m_internal_population[i].objective < min_objective 
 	          || ((EdgeWeight)m_internal_population[i].objective == min_objective && cur_balance < best_balance)) {
@@ -410,27 +407,40 @@ void population::apply_fittest( graph_access & G, EdgeWeight & objective ) {
                 }
         }
 
-        forall_nodes(G, node) {
-                G.setPartitionIndex(node, m_internal_population[idx].partition_map[node]);
-        } endfor
+        m_internal_population[idx].partition_map->apply(G);
 
         objective = min_objective;
 }
 
 void population::print() {
-        int rank;
-        MPI_Comm_rank( m_communicator, &rank);
-        
-        std::cout <<  "rank " <<  rank << " fingerprint ";
+        if( m_communicator == MPI_COMM_NULL ) {
+                std::cout <<  "island " <<  m_island_id << " fingerprint ";
+        } else {
+                int rank;
+                MPI_Comm_rank( m_communicator, &rank);
+                std::cout <<  "rank " <<  rank << " fingerprint ";
+        }
 
         for( unsigned i = 0; i < m_internal_population.size(); i++) {
                 std::cout <<  m_internal_population[i].objective << " ";
         }         
 
         std::cout <<  std::endl;
+        std::cout <<  "population memory " <<  memory() << " bytes" << std::endl;
+}
+
+uint64_t population::memory() {
+        std::lock_guard< std::mutex > guard(m_mutex);
+        uint64_t bytes = 0;
+        for( unsigned i = 0; i < m_internal_population.size(); i++) {
+                bytes += m_internal_population[i].partition_map->memory();
+                bytes += m_internal_population[i].cut_edges->memory();
+        }
+        return bytes;
 }
 
 void population::write_log(std::string & filename) {
+        std::lock_guard< std::mutex > guard(m_mutex);
         std::ofstream f(filename.c_str());
         f << m_filebuffer_string.str();
         f.close();
@@ -8,26 +8,33 @@
 #ifndef POPULATION_AEFH46G6
 #define POPULATION_AEFH46G6
 
-#include <sstream>
 #include <mpi.h>
+#include <mutex>
+#include <sstream>
 
+#include "compact_individuum.h"
 #include "data_structure/graph_access.h"
 #include "partition_config.h"
 #include "timer.h"
 
+// copies of an individuum share its (immutable) partition map and cut edges
 struct Individuum {
-        int* partition_map;
+        packed_partition_ptr partition_map;
         EdgeWeight objective;
-        std::vector<EdgeID>* cut_edges; //sorted
+        packed_edge_set_ptr cut_edges; //sorted
 };
 
 struct ENC {
         std::vector<NodeID> vertices;
 };
 
+// selection, insert and replace may be called concurrently by the pipeline workers
+// of an island, they are short and guarded by a lock; the operators are not
 class population {
         public:
                 population( MPI_Comm comm, const PartitionConfig & config );
+                // island that is a thread of a shared-memory run, does not use MPI
+                population( const PartitionConfig & config, int island_id );
                 virtual ~population();
 
                 void createIndividuum(const PartitionConfig & config, 
@@ -62,7 +69,8 @@ class population {
 
                 void get_two_individuals_tournament(Individuum & first, Individuum & second);
 
-                void replace(Individuum & in, Individuum & out);
+                // returns false if in is not part of the population anymore
+                bool replace(Individuum & in, Individuum & out);
 
                 void get_random_individuum(Individuum & ind);
 
@@ -72,30 +80,43 @@ class population {
 
                 void apply_fittest( graph_access & G, EdgeWeight & objective);
 
-                unsigned size() { return m_internal_population.size(); }
+                unsigned size() { 
+                        std::lock_guard< std::mutex > guard(m_mutex);
+                        return m_internal_population.size(); 
+                }
                 
                 void print();
 
                 void write_log(std::string & filename);
 
+                // bytes held by the individuals of this island
+                uint64_t memory();
+
 
         private:
+                void createIndividuum(const PartitionConfig & config, 
+                                      graph_access & G, 
+				      Individuum & ind, 
+				      bool output,
+                                      const packed_partition_ptr & parent); 
 
                 unsigned                m_no_partition_calls;
                 unsigned 		m_population_size;
                 std::vector<Individuum> m_internal_population;
-                std::vector< std::vector< unsigned int > > m_vertex_ENCs;
                 std::vector< ENC > m_ENCs;
 
                 int m_num_NCs;
                 int m_num_NCs_computed;
                 int m_num_ENCs;
                 int m_time_stamp;
+                int m_island_id;
 
                 MPI_Comm m_communicator;
 
                 std::stringstream m_filebuffer_string;
                 timer   	  m_global_timer;
+
+                std::mutex m_mutex;
 };
 
 
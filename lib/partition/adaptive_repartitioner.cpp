@@ -0,0 +1,196 @@
+/******************************************************************************
+ * adaptive_repartitioner.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "adaptive_repartitioner.h"
+#include "graph_partitioner.h"
+
+adaptive_repartitioner::adaptive_repartitioner() {
+
+}
+
+adaptive_repartitioner::~adaptive_repartitioner() {
+
+}
+
+void adaptive_repartitioner::perform_repartitioning( PartitionConfig & config, graph_access & G,
+                                                     const std::vector< PartitionID > & old_partition,
+                                                     const std::vector< NodeID > & changed_nodes,
+                                                     double max_migration ) {
+        G.set_partition_count(config.k);
+        m_block_weights.assign(config.k, 0);
+        m_connectivity.assign(config.k, 0);
+        m_touched.clear();
+
+        std::vector< bool >   unassigned(G.number_of_nodes(), false);
+        std::vector< NodeID > nodes;
+        NodeWeight total_weight = 0;
+        forall_nodes(G, node) {
+                total_weight += G.getNodeWeight(node);
+                if( old_partition[node] >= config.k ) {
+                        unassigned[node] = true;
+                        nodes.push_back(node);
+                } else {
+                        G.setPartitionIndex(node, old_partition[node]);
+                }
+        } endfor
+
+        for( unsigned i = 0; i < changed_nodes.size(); i++) {
+                NodeID node = changed_nodes[i];
+                if( !unassigned[node] ) {
+                        unassigned[node] = true;
+                        nodes.push_back(node);
+                }
+        }
+
+        forall_nodes(G, node) {
+                if( !unassigned[node] ) m_block_weights[G.getPartitionIndex(node)] += G.getNodeWeight(node);
+        } endfor
+
+        assign_changed_nodes(config, G, unassigned, nodes);
+        rebalance(config, G);
+
+        // V-cycle starting from the given partition
+        config.graph_allready_partitioned  = true;
+        config.no_new_initial_partitioning = true;
+
+        graph_partitioner partitioner;
+        partitioner.perform_partitioning(config, G);
+
+        if( max_migration >= 0 ) {
+                m_block_weights.assign(config.k, 0);
+                forall_nodes(G, node) {
+                        m_block_weights[G.getPartitionIndex(node)] += G.getNodeWeight(node);
+                } endfor
+                limit_migration(config, G, old_partition, (NodeWeight)(max_migration * total_weight));
+        }
+}
+
+void adaptive_repartitioner::assign_changed_nodes( const PartitionConfig & config, graph_access & G, 
+                                                   std::vector< bool > & unassigned, std::vector< NodeID > & nodes ) {
+        // nodes are assigned once they have an assigned neighbor, the remaining ones go to the lightest block
+        bool progress = true;
+        while( !nodes.empty() && progress ) {
+                progress = false;
+                unsigned remaining = 0;
+                for( unsigned i = 0; i < nodes.size(); i++) {
+                        NodeID node = nodes[i];
+                        compute_connectivity(G, node, &unassigned);
+                        if( m_touched.empty() ) {
+                                nodes[remaining++] = node;
+                                continue;
+                        }
+
+                        NodeWeight weight = G.getNodeWeight(node);
+                        PartitionID best  = config.k;
+                        for( unsigned j = 0; j < m_touched.size(); j++) {
+                                PartitionID block = m_touched[j];
+                                if( m_block_weights[block] + weight > config.upper_bound_partition ) continue;
+                                if( best == config.k || m_connectivity[block] > m_connectivity[best] ) best = block;
+                        }
+                        clear_connectivity();
+                        if( best == config.k ) {
+                                best = std::min_element(m_block_weights.begin(), m_block_weights.end()) - m_block_weights.begin();
+                        }
+
+                        G.setPartitionIndex(node, best);
+                        m_block_weights[best] += weight;
+                        unassigned[node]       = false;
+                        progress               = true;
+                }
+                nodes.resize(remaining);
+        }
+
+        for( unsigned i = 0; i < nodes.size(); i++) {
+                PartitionID best = std::min_element(m_block_weights.begin(), m_block_weights.end()) - m_block_weights.begin();
+                G.setPartitionIndex(nodes[i], best);
+                m_block_weights[best] += G.getNodeWeight(nodes[i]);
+                unassigned[nodes[i]]   = false;
+        }
+}
+
+void adaptive_repartitioner::rebalance( const PartitionConfig & config, graph_access & G ) {
+        // moves nodes of overloaded blocks to the best connected block that can take them,
+        // to the lightest block if no adjacent block can
+        forall_nodes(G, node) {
+                PartitionID from  = G.getPartitionIndex(node);
+                NodeWeight weight = G.getNodeWeight(node);
+                if( m_block_weights[from] <= config.upper_bound_partition ) continue;
+
+                compute_connectivity(G, node, NULL);
+                PartitionID best = config.k;
+                for( unsigned j = 0; j < m_touched.size(); j++) {
+                        PartitionID block = m_touched[j];
+                        if( block == from || m_block_weights[block] + weight > config.upper_bound_partition ) continue;
+                        if( best == config.k || m_connectivity[block] > m_connectivity[best] ) best = block;
+                }
+                clear_connectivity();
+
+                if( best == config.k ) {
+                        best = std::min_element(m_block_weights.begin(), m_block_weights.end()) - m_block_weights.begin();
+                        if( best == from || m_block_weights[best] + weight > config.upper_bound_partition ) continue;
+                }
+
+                G.setPartitionIndex(node, best);
+                m_block_weights[from] -= weight;
+                m_block_weights[best] += weight;
+        } endfor
+}
+
+void adaptive_repartitioner::limit_migration( const PartitionConfig & config, graph_access & G,
+                                              const std::vector< PartitionID > & old_partition,
+                                              NodeWeight max_migrated_weight ) {
+        NodeWeight migrated = 0;
+        std::vector< std::pair< EdgeWeight, NodeID > > moved;
+        forall_nodes(G, node) {
+                PartitionID old_block = old_partition[node];
+                PartitionID cur_block = G.getPartitionIndex(node);
+                if( old_block >= config.k || old_block == cur_block ) continue;
+
+                migrated += G.getNodeWeight(node);
+
+                // increase of the cut if the node goes back
+                compute_connectivity(G, node, NULL);
+                moved.push_back(std::make_pair(m_connectivity[cur_block] - m_connectivity[old_block], node));
+                clear_connectivity();
+        } endfor
+
+        if( migrated <= max_migrated_weight ) return;
+
+        std::sort(moved.begin(), moved.end());
+        for( unsigned i = 0; i < moved.size() && migrated > max_migrated_weight; i++) {
+                NodeID node          = moved[i].second;
+                NodeWeight weight    = G.getNodeWeight(node);
+                PartitionID to       = old_partition[node];
+                PartitionID from     = G.getPartitionIndex(node);
+                if( m_block_weights[to] + weight > config.upper_bound_partition ) continue;
+
+                G.setPartitionIndex(node, to);
+                m_block_weights[from] -= weight;
+                m_block_weights[to]   += weight;
+                migrated              -= weight;
+        }
+}
+
+void adaptive_repartitioner::compute_connectivity( graph_access & G, NodeID node, const std::vector< bool > * unassigned ) {
+        forall_out_edges(G, e, node) {
+                NodeID target = G.getEdgeTarget(e);
+                if( unassigned != NULL && (*unassigned)[target] ) continue;
+
+                PartitionID block = G.getPartitionIndex(target);
+                if( m_connectivity[block] == 0 ) m_touched.push_back(block);
+                m_connectivity[block] += G.getEdgeWeight(e);
+        } endfor
+}
+
+void adaptive_repartitioner::clear_connectivity() {
+        for( unsigned i = 0; i < m_touched.size(); i++) {
+                m_connectivity[m_touched[i]] = 0;
+        }
+        m_touched.clear();
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * adaptive_repartitioner.h 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef ADAPTIVE_REPARTITIONER_W2P8LQ5N
+#define ADAPTIVE_REPARTITIONER_W2P8LQ5N
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+// repartitioning of a graph that changed slightly, warm started from the old partition.
+// nodes without a valid old block and the changed nodes are assigned to their best connected block,
+// overloaded blocks are rebalanced greedily, and a V-cycle is run from the resulting partition
+// (coarsening only inside blocks, no new initial partitioning). finally, if more than
+// max_migration of the total node weight has left its old block, the moves that are cheapest
+// in terms of the cut are undone as long as the balance constraint allows it.
+// config has to be configured for G (balance_configuration), the result is the partition of G
+class adaptive_repartitioner {
+public:
+        adaptive_repartitioner();
+        virtual ~adaptive_repartitioner();
+
+        // old_partition[v] outside of [0,k) marks a new node, max_migration < 0 means no limit
+        void perform_repartitioning( PartitionConfig & config, graph_access & G,
+                                     const std::vector< PartitionID > & old_partition,
+                                     const std::vector< NodeID > & changed_nodes,
+                                     double max_migration );
+
+private:
+        void assign_changed_nodes( const PartitionConfig & config, graph_access & G, 
+                                   std::vector< bool > & unassigned, std::vector< NodeID > & nodes );
+
+        void rebalance( const PartitionConfig & config, graph_access & G );
+
+        void limit_migration( const PartitionConfig & config, graph_access & G,
+                              const std::vector< PartitionID > & old_partition,
+                              NodeWeight max_migrated_weight );
+
+        // weight of the edges of node to every block, m_touched lists the blocks with a nonzero entry
+        void compute_connectivity( graph_access & G, NodeID node, const std::vector< bool > * unassigned );
+        void clear_connectivity();
+
+        std::vector< NodeWeight > m_block_weights;
+        std::vector< EdgeWeight > m_connectivity;
+        std::vector< PartitionID > m_touched;
+};
+
+
+#endif /* end of include guard: ADAPTIVE_REPARTITIONER_W2P8LQ5N */
@@ -17,6 +17,7 @@
 #include "graph_io.h"
 #include "matching/gpa/gpa_matching.h"
 #include "matching/random_matching.h"
+#include "phase_timer.h"
 #include "stop_rules/stop_rules.h"
 
 coarsening::coarsening() {
@@ -28,6 +29,8 @@ coarsening::~coarsening() {
 }
 
 void coarsening::perform_coarsening(const PartitionConfig & partition_config, graph_access & G, graph_hierarchy & hierarchy) {
+        phase_scope coarsening_phase("coarsening");
+        phase_timer* ptimer = phase_timer::getInstance();
 
         NodeID no_of_coarser_vertices = G.number_of_nodes();
         NodeID no_of_finer_vertices   = G.number_of_nodes();
@@ -63,15 +66,24 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
                 Matching edge_matching;
                 NodePermutationMap permutation;
 
+                ptimer->begin("level " + std::to_string(level));
+                ptimer->set_value("nodes", finer->number_of_nodes());
+                ptimer->set_value("edges", finer->number_of_edges());
+
                 coarsening_config.configure_coarsening(copy_of_partition_config, &edge_matcher, level);
-                if( partition_config.matching_type != CLUSTER_COARSENING) 
+                if( partition_config.matching_type != CLUSTER_COARSENING) {
+                        phase_scope rating_phase("rating");
                         rating.rate(*finer, level);
+                }
 
+                ptimer->begin("matching");
                 edge_matcher->match(copy_of_partition_config, *finer, edge_matching, 
                                     *coarse_mapping, no_of_coarser_vertices, permutation);
+                ptimer->end();
 
                 delete edge_matcher; 
 
+                ptimer->begin("contraction");
                 if(partition_config.graph_allready_partitioned) {
                         contracter->contract_partitioned(copy_of_partition_config, *finer, *coarser, edge_matching, 
                                                          *coarse_mapping, no_of_coarser_vertices, permutation);
@@ -79,6 +91,11 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
                         contracter->contract(copy_of_partition_config, *finer, *coarser, edge_matching, 
                                              *coarse_mapping, no_of_coarser_vertices, permutation);
                 }
+                if(partition_config.release_edge_ratings) {
+                        finer->release_edge_ratings();
+                }
+                ptimer->end();
+                ptimer->end();
 
                 hierarchy.push_back(finer, coarse_mapping);
                 contraction_stop = coarsening_stop_rule->stop(no_of_finer_vertices, no_of_coarser_vertices);
@@ -91,6 +108,7 @@ void coarsening::perform_coarsening(const PartitionConfig & partition_config, gr
         } while( contraction_stop ); 
 
         hierarchy.push_back(finer, NULL); // append the last created level
+        if(ptimer->enabled()) ptimer->set_value("hierarchy_bytes", hierarchy.memory());
 
         delete contracter;
         delete coarsening_stop_rule;
@@ -20,6 +20,9 @@ edge_ratings::~edge_ratings() {
 }
 
 void edge_ratings::rate(graph_access & G, unsigned level) {
+        // the ratings may have been released after an earlier contraction of G
+        G.allocate_edge_ratings();
+
         //rate the edges
         if(level == 0 && partition_config.first_level_random_matching) {
                 return;
@@ -8,9 +8,9 @@
 #include <algorithm>
 #include <deque>
 
-#include "compare_rating.h"
 #include "gpa_matching.h"
 #include "macros_assertions.h"
+#include "radix_sort.h"
 #include "random_functions.h"
 
 gpa_matching::gpa_matching() {
@@ -46,17 +46,20 @@ void gpa_matching::match(const PartitionConfig & partition_config,
                 random_functions::permutate_entries(gpa_perm_config, edge_permutation, false);
         }
 
-        compare_rating cmp(&G);
-        std::sort(edge_permutation.begin(), edge_permutation.end(), cmp);
+        // stable radix sort by decreasing rating, i.e. ties keep the order of the permutation above
+        std::vector<uint64_t> keys(edge_permutation.size());
+        for( unsigned i = 0; i < edge_permutation.size(); i++) {
+                keys[i] = ~radix_sort::ordered_key(G.getEdgeRating(edge_permutation[i]));
+        }
+        radix_sort::sort(keys, edge_permutation, partition_config.num_threads);
 
         path_set pathset(&G, &partition_config);
 
         //grow the paths
-        forall_edges(G, e) {
-                EdgeID curEdge = edge_permutation[e];
+        for( unsigned i = 0; i < edge_permutation.size(); i++) {
+                EdgeID curEdge = edge_permutation[i];
                 NodeID source  = sources[curEdge];
                 NodeID target  = G.getEdgeTarget(curEdge); 
-                if(target < source) continue; // get rid of double edges
 
                 if(G.getEdgeRating(curEdge) == 0.0) {
                         continue;
@@ -74,7 +77,7 @@ void gpa_matching::match(const PartitionConfig & partition_config,
                 }
 
                 pathset.add_if_applicable(source, curEdge);
-        } endfor 
+        }
 
         extract_paths_apply_matching(G, sources, edge_matching, pathset); 
 
@@ -141,7 +144,8 @@ void gpa_matching::init(graph_access & G,
 
                 forall_out_edges(G, e, n) {
                         sources[e] = n;   
-                        edge_permutation.push_back(e);
+                        // only one direction of an edge can be matched
+                        if(n < G.getEdgeTarget(e)) edge_permutation.push_back(e);
 
                         if(partition_config.edge_rating == WEIGHT) {
                                 // in that case we need to copy it
@@ -0,0 +1,118 @@
+/******************************************************************************
+ * local_max_matching.cpp 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <omp.h>
+
+#include "local_max_matching.h"
+#include "macros_assertions.h"
+
+local_max_matching::local_max_matching() {
+
+}
+
+local_max_matching::~local_max_matching() {
+
+}
+
+void local_max_matching::match(const PartitionConfig & partition_config, 
+                               graph_access & G, 
+                               Matching & edge_matching,
+                               CoarseMapping & coarse_mapping,
+                               NodeID & no_of_coarse_vertices,
+                               NodePermutationMap & permutation) {
+        PRINT(std::cout<< "matching using local max" << std::endl;)
+        permutation.resize(G.number_of_nodes());
+        edge_matching.resize(G.number_of_nodes());
+        coarse_mapping.resize(G.number_of_nodes());
+
+        int num_threads = std::max(1, partition_config.num_threads);
+
+        std::vector< NodeID > active;
+        active.reserve(G.number_of_nodes());
+        forall_nodes(G, n) {
+                permutation[n]   = n;
+                edge_matching[n] = n;
+                active.push_back(n);
+
+                if(partition_config.edge_rating == WEIGHT) {
+                        // in that case we need to copy it
+                        forall_out_edges(G, e, n) {
+                                G.setEdgeRating(e, G.getEdgeWeight(e));
+                        } endfor
+                }
+        } endfor
+
+        std::vector< NodeID > candidate(G.number_of_nodes());
+        while( !active.empty() ) {
+                #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024)
+                for( long i = 0; i < (long)active.size(); i++) {
+                        candidate[active[i]] = best_neighbor(partition_config, G, edge_matching, active[i]);
+                }
+
+                #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1024)
+                for( long i = 0; i < (long)active.size(); i++) {
+                        NodeID n = active[i];
+                        if( candidate[n] != n && candidate[candidate[n]] == n ) {
+                                edge_matching[n] = candidate[n];
+                        }
+                }
+
+                // nodes that are unmatched but still have an eligible neighbor stay active
+                NodeID matched = 0;
+                unsigned remaining = 0;
+                for( unsigned i = 0; i < active.size(); i++) {
+                        NodeID n = active[i];
+                        if( edge_matching[n] != n ) {
+                                matched++;
+                        } else if( candidate[n] != n ) {
+                                active[remaining++] = n;
+                        }
+                }
+                active.resize(remaining);
+
+                if( matched == 0 ) break;
+        }
+
+        no_of_coarse_vertices = 0;
+        forall_nodes(G, n) {
+                if( n < edge_matching[n]) {
+                        coarse_mapping[n]                = no_of_coarse_vertices;
+                        coarse_mapping[edge_matching[n]] = no_of_coarse_vertices;
+                        no_of_coarse_vertices++;
+                } else if(n == edge_matching[n]) {
+                        coarse_mapping[n] = no_of_coarse_vertices;
+                        no_of_coarse_vertices++;
+                }
+        } endfor
+}
+
+NodeID local_max_matching::best_neighbor( const PartitionConfig & config, graph_access & G, 
+                                          Matching & edge_matching, NodeID n ) {
+        NodeID         best        = n;
+        EdgeRatingType best_rating = 0;
+        uint64_t       best_hash   = 0;
+        NodeWeight     weight      = G.getNodeWeight(n);
+
+        forall_out_edges(G, e, n) {
+                NodeID target = G.getEdgeTarget(e);
+                EdgeRatingType rating = G.getEdgeRating(e);
+                if( edge_matching[target] != target || rating <= 0 ) continue;
+                if( weight + G.getNodeWeight(target) > config.max_vertex_weight ) continue;
+                if( config.graph_allready_partitioned && G.getPartitionIndex(n) != G.getPartitionIndex(target) ) continue;
+                if( config.combine && G.getSecondPartitionIndex(n) != G.getSecondPartitionIndex(target) ) continue;
+
+                if( rating < best_rating ) continue;
+                uint64_t hash = edge_hash(config, n, target);
+                if( rating > best_rating || hash > best_hash ) {
+                        best        = target;
+                        best_rating = rating;
+                        best_hash   = hash;
+                }
+        } endfor
+
+        return best;
+}
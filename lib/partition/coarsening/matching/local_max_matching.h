@@ -0,0 +1,44 @@
+/******************************************************************************
+ * local_max_matching.h 
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef LOCAL_MAX_MATCHING_H4XW9C2E
+#define LOCAL_MAX_MATCHING_H4XW9C2E
+
+#include "matching.h"
+
+// parallel matching on the edge ratings: in every round each unmatched node proposes to the neighbor
+// with the highest rated eligible edge, mutual proposals are matched (locally maximal edges).
+// rounds only read the state of the previous round, hence the result does not depend on config.num_threads
+class local_max_matching : public matching {
+        public:
+                local_max_matching();
+                virtual ~local_max_matching();
+
+                void match(const PartitionConfig & config, 
+                           graph_access & G, 
+                           Matching & _matching, 
+                           CoarseMapping & coarse_mapping, 
+                           NodeID & no_of_coarse_vertices,
+                           NodePermutationMap & permutation);
+
+        private:
+                // node the edges of n are proposed to, n if there is no eligible edge
+                NodeID best_neighbor( const PartitionConfig & config, graph_access & G, 
+                                      Matching & edge_matching, NodeID n );
+
+                // symmetric tie breaking of edges with the same rating
+                inline uint64_t edge_hash( const PartitionConfig & config, NodeID u, NodeID v ) {
+                        uint64_t key = u < v ? ((uint64_t)u << 32) | v : ((uint64_t)v << 32) | u;
+                        key ^= (uint64_t)config.seed * 0x9e3779b97f4a7c15ULL;
+                        key ^= key >> 33;
+                        key *= 0xff51afd7ed558ccdULL;
+                        key ^= key >> 33;
+                        return key;
+                }
+};
+
+#endif /* end of include guard: LOCAL_MAX_MATCHING_H4XW9C2E */
@@ -3,6 +3,7 @@
 // 
 
 #include <fstream>
+#include <omp.h>
 #include "initial_node_separator.h"
 #include "graph_partitioner.h"
 #include "tools/quality_metrics.h"
@@ -20,11 +21,21 @@ initial_node_separator::~initial_node_separator() {
 
 NodeWeight initial_node_separator::single_run( const PartitionConfig & config, graph_access & G) {
 
-        std::streambuf* backup = std::cout.rdbuf();
         std::ofstream ofs;
+        if( omp_in_parallel() ) {
+                // std::cout is shared, concurrent callers have to silence it themselves
+                return single_run_internal(config, G, ofs, NULL);
+        }
+
+        std::streambuf* backup = std::cout.rdbuf();
         ofs.open("/dev/null");
         std::cout.rdbuf(ofs.rdbuf()); 
 
+        return single_run_internal(config, G, ofs, backup);
+}
+
+NodeWeight initial_node_separator::single_run_internal( const PartitionConfig & config, graph_access & G, 
+                                                        std::ofstream & ofs, std::streambuf* backup) {
         graph_partitioner partitioner;
         PartitionConfig partition_config         = config;
         partition_config.mode_node_separators    = false;
@@ -37,8 +48,10 @@ NodeWeight initial_node_separator::single_run( const PartitionConfig & config, g
         complete_boundary boundary(&G);
         boundary.build();
 
-        ofs.close();
-        std::cout.rdbuf(backup);
+        if( backup != NULL ) {
+                ofs.close();
+                std::cout.rdbuf(backup);
+        }
 
         vertex_separator_algorithm vsa; std::vector<NodeID> separator;
         //create a very simple separator from that partition
@@ -59,6 +72,10 @@ NodeWeight initial_node_separator::single_run( const PartitionConfig & config, g
 
 void initial_node_separator::compute_node_separator( const PartitionConfig & config, graph_access & G) {
         if(config.graph_allready_partitioned) return;
+        if(config.num_threads > 1) {
+                compute_node_separator_parallel(config, G);
+                return;
+        }
 
         std::vector< NodeID > best_separator(G.number_of_nodes(),0);
         NodeWeight best_separator_size = std::numeric_limits< NodeWeight >::max();
@@ -89,3 +106,70 @@ void initial_node_separator::compute_node_separator( const PartitionConfig & con
         } endfor
         
 }
+
+void initial_node_separator::compute_node_separator_parallel( const PartitionConfig & config, graph_access & G) {
+        int num_tries   = config.max_initial_ns_tries;
+        int num_threads = std::min(config.num_threads, num_tries);
+
+        // seeds are drawn upfront so that the result only depends on the seed and the number of tries
+        std::vector< int > seeds(num_tries, 0);
+        for( int i = 0; i < num_tries; i++) {
+                seeds[i] = random_functions::nextInt(0, std::numeric_limits<int>::max());
+        }
+        // the calling thread also runs tries, its generator is reset afterwards
+        int continuation_seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+
+        std::vector< NodeID > best_separator(G.number_of_nodes(),0);
+        NodeWeight best_separator_size = std::numeric_limits< NodeWeight >::max();
+        int best_try = num_tries;
+
+        // std::cout is shared by all threads, hence we silence it once for the whole parallel region
+        bool redirect = !omp_in_parallel();
+        std::streambuf* backup = std::cout.rdbuf();
+        std::ofstream ofs;
+        if( redirect ) {
+                ofs.open("/dev/null");
+                std::cout.rdbuf(ofs.rdbuf()); 
+        }
+
+        #pragma omp parallel num_threads(num_threads)
+        {
+                graph_access local_G;
+                G.copy(local_G);
+                local_G.set_partition_count(G.get_partition_count());
+
+                #pragma omp for schedule(dynamic, 1)
+                for( int i = 0; i < num_tries; i++) {
+                        // every try starts from the same state, independent of the thread that runs it
+                        random_functions::setSeed(seeds[i]);
+                        local_G.set_partition_count(G.get_partition_count());
+                        forall_nodes(local_G, node) {
+                                local_G.setPartitionIndex(node, G.getPartitionIndex(node));
+                        } endfor
+                        NodeWeight cur_separator_size = single_run_internal(config, local_G, ofs, NULL);
+
+                        #pragma omp critical
+                        {
+                                if(cur_separator_size < best_separator_size 
+                                || (cur_separator_size == best_separator_size && i < best_try)) {
+                                        forall_nodes(local_G, node) {
+                                                best_separator[node] = local_G.getPartitionIndex(node);
+                                        } endfor
+                                        best_separator_size = cur_separator_size;
+                                        best_try            = i;
+                                }
+                        }
+                }
+        }
+
+        random_functions::setSeed(continuation_seed);
+        if( redirect ) {
+                ofs.close();
+                std::cout.rdbuf(backup);
+        }
+        std::cout <<  "improved initial separator size " <<  best_separator_size  << std::endl;
+
+        forall_nodes(G, node) {
+                G.setPartitionIndex(node, best_separator[node]);
+        } endfor
+}
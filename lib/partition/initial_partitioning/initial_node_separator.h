@@ -5,6 +5,8 @@
 #ifndef INITIAL_NODE_SEPARATOR_VR5EPEO6
 #define INITIAL_NODE_SEPARATOR_VR5EPEO6
 
+#include <fstream>
+
 #include "data_structure/graph_access.h"
 #include "partition_config.h"
 
@@ -16,6 +18,14 @@ public:
         // method computes an initial node separator
         void compute_node_separator( const PartitionConfig & config, graph_access & G);
         NodeWeight single_run( const PartitionConfig & config, graph_access & G);
+
+private:
+        // runs the tries concurrently on private copies of G (config.num_threads > 1)
+        void compute_node_separator_parallel( const PartitionConfig & config, graph_access & G);
+
+        // backup == NULL means that std::cout is already redirected by the caller
+        NodeWeight single_run_internal( const PartitionConfig & config, graph_access & G, 
+                                        std::ofstream & ofs, std::streambuf* backup);
 };
 
 
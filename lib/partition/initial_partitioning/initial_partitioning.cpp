@@ -14,6 +14,7 @@
 #include "initial_partitioning.h"
 #include "initial_refinement/initial_refinement.h"
 #include "initial_node_separator.h"
+#include "phase_timer.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 #include "timer.h"
@@ -37,6 +38,9 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
 
 
 void initial_partitioning::perform_initial_partitioning(const PartitionConfig & config, graph_access &  G) {
+        phase_scope initial_partitioning_phase("initial_partitioning");
+        phase_timer::getInstance()->set_value("nodes", G.number_of_nodes());
+        phase_timer::getInstance()->set_value("edges", G.number_of_edges());
 
         initial_partitioner* partition = NULL;
         switch(config.initial_partitioning_type) {
@@ -122,6 +126,7 @@ void initial_partitioning::perform_initial_partitioning(const PartitionConfig &
         }
 
         ASSERT_TRUE(graph_partition_assertions::assert_graph_has_kway_partition(config, G));
+        phase_timer::getInstance()->set_value("cut", best_cut);
 
         delete[] partition_map;
         delete[] best_map;
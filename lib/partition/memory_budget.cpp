@@ -0,0 +1,129 @@
+/******************************************************************************
+ * memory_budget.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <unistd.h>
+
+#include "data_structure/flow_graph.h"
+#include "memory_budget.h"
+
+// a coarser level has at most this fraction of the nodes / edges of the finer level
+// (matchings halve the nodes, the edges of complex networks shrink slower)
+static const double NODE_SHRINK = 0.5;
+static const double EDGE_SHRINK = 0.7;
+
+// fraction of boundary nodes of the finest level. a boundary node is stored in about two partial
+// boundaries (hash table entries) and once in a refinement queue (hash table entry and bucket slot)
+static const double BOUNDARY_FRACTION   = 0.25;
+static const double BOUNDARY_NODE_BYTES = 2 * (sizeof(NodeID) + 3 * sizeof(void*));
+static const double QUEUE_NODE_BYTES    = sizeof(NodeID) + 2 * sizeof(Gain) + 3 * sizeof(void*) + sizeof(NodeID);
+
+// per node of a flow problem: offsets, id mapping, bfs stripe and the arrays of push relabel
+static const double FLOW_NODE_BYTES = sizeof(EdgeID) + 3 * sizeof(NodeID) + 2 * sizeof(long) + 4 * sizeof(NodeID) + 2;
+
+uint64_t memory_budget::resident_memory() {
+        std::ifstream statm("/proc/self/statm");
+        uint64_t size = 0, resident = 0;
+        if( !(statm >> size >> resident) ) return 0;
+        return resident * sysconf(_SC_PAGESIZE);
+}
+
+bool memory_budget::uses_flows(const PartitionConfig & config) {
+        return !config.label_propagation_refinement
+            && !config.quotient_graph_refinement_disabled
+            && (config.refinement_type == REFINEMENT_TYPE_FM_FLOW || config.refinement_type == REFINEMENT_TYPE_FLOW);
+}
+
+uint64_t memory_budget::projected_usage(const PartitionConfig & config, graph_access & G) {
+        double n = G.number_of_nodes();
+        double m = G.number_of_edges();
+
+        double node_bytes   = sizeof(Node) + sizeof(refinementNode);
+        double edge_bytes   = sizeof(Edge);
+        double rating_bytes = sizeof(coarseningEdge);
+
+        // all coarse levels together
+        double coarse_nodes = n * NODE_SHRINK / (1 - NODE_SHRINK);
+        double coarse_edges = m * EDGE_SHRINK / (1 - EDGE_SHRINK);
+        double mappings     = (n + coarse_nodes) * sizeof(NodeID);
+
+        // end of the coarsening: all levels and mappings, the ratings of all levels or only of the
+        // level that is contracted next, and the new edge targets of the contraction
+        double coarsening = coarse_nodes * node_bytes + coarse_edges * edge_bytes + mappings + m * sizeof(NodeID);
+        coarsening       += (config.release_edge_ratings ? m * EDGE_SHRINK : coarse_edges) * rating_bytes;
+
+        // refinement of the finest level: boundary, queues and the largest flow problem, plus the
+        // second level, its boundary and all mappings if the coarse levels are kept
+        double boundary_nodes = config.label_propagation_refinement ? 0 : BOUNDARY_FRACTION * n;
+        double uncoarsening   = boundary_nodes * (BOUNDARY_NODE_BYTES + QUEUE_NODE_BYTES);
+
+        if( uses_flows(config) && config.k > 1 ) {
+                // both stripes of a flow problem may reach flow_region_factor * imbalance percent of a block
+                double region_nodes = std::min(n, 2 * config.flow_region_factor * config.imbalance / 100.0 * n / config.k);
+                double region_edges = n > 0 ? region_nodes * m / n : 0;
+                uncoarsening       += region_nodes * FLOW_NODE_BYTES + region_edges * (2 * sizeof(rEdge) + sizeof(NodeID) + sizeof(FlowType) + sizeof(NodeID));
+        }
+
+        if( !config.release_coarse_levels ) {
+                uncoarsening += n * NODE_SHRINK * node_bytes + m * EDGE_SHRINK * edge_bytes;
+                uncoarsening += NODE_SHRINK * boundary_nodes * BOUNDARY_NODE_BYTES + mappings;
+                if( !config.release_edge_ratings ) uncoarsening += m * EDGE_SHRINK * rating_bytes;
+        }
+
+        return (uint64_t) std::max(coarsening, uncoarsening);
+}
+
+bool memory_budget::apply(PartitionConfig & config, graph_access & G, unsigned concurrent_runs) {
+        if( config.memory_budget <= 0 ) return true;
+
+        uint64_t budget   = (uint64_t)(config.memory_budget * 1024 * 1024);
+        uint64_t resident = resident_memory();
+        uint64_t peak     = resident + concurrent_runs * projected_usage(config, G);
+        if( peak <= budget ) return true;
+
+        std::cout <<  "memory budget " <<  config.memory_budget << " MB, projected peak " <<  peak / (1024*1024) << " MB"  << std::endl;
+
+        if( !config.release_edge_ratings ) {
+                config.release_edge_ratings = true;
+                peak = resident + concurrent_runs * projected_usage(config, G);
+                std::cout <<  "freeing edge ratings after contraction, projected peak " <<  peak / (1024*1024) << " MB"  << std::endl;
+                if( peak <= budget ) return true;
+        }
+
+        if( !config.release_coarse_levels ) {
+                config.release_coarse_levels = true;
+                peak = resident + concurrent_runs * projected_usage(config, G);
+                std::cout <<  "freeing coarse levels after projection, projected peak " <<  peak / (1024*1024) << " MB"  << std::endl;
+                if( peak <= budget ) return true;
+        }
+
+        if( uses_flows(config) ) {
+                while( peak > budget && config.flow_region_factor > 1 ) {
+                        config.flow_region_factor = std::max(1.0, config.flow_region_factor / 2);
+                        peak = resident + concurrent_runs * projected_usage(config, G);
+                }
+                std::cout <<  "flow region factor " <<  config.flow_region_factor << ", projected peak " <<  peak / (1024*1024) << " MB"  << std::endl;
+                if( peak <= budget ) return true;
+        }
+
+        std::cout <<  "the memory budget is exceeded even in the cheapest mode"  << std::endl;
+        return false;
+}
+
+unsigned memory_budget::affordable_individuals(const PartitionConfig & config, graph_access & G,
+                                               uint64_t individuum_bytes, unsigned islands) {
+        if( config.memory_budget <= 0 ) return std::numeric_limits< unsigned >::max();
+
+        uint64_t budget = (uint64_t)(config.memory_budget * 1024 * 1024);
+        uint64_t used   = resident_memory() + islands * projected_usage(config, G);
+        if( used >= budget ) return 0;
+
+        return (budget - used) / (std::max((uint64_t)1, individuum_bytes) * std::max(1u, islands));
+}
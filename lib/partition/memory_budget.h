@@ -0,0 +1,45 @@
+/******************************************************************************
+ * memory_budget.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef MEMORY_BUDGET_T4N8WQ2E
+#define MEMORY_BUDGET_T4N8WQ2E
+
+#include <stdint.h>
+
+#include "data_structure/graph_access.h"
+#include "partition_config.h"
+
+// keeps a multilevel run within config.memory_budget (MB, 0 means no budget).
+// the peak of a run is projected from the size of the input graph: the coarse levels, the mappings and
+// the edge ratings at the end of the coarsening, and the boundary, the refinement queues, the flow problems
+// and the levels that are still kept while the finest level is refined. if the resident memory plus the
+// projection exceeds the budget, cheaper modes are selected in this order: free the edge ratings of a level
+// once it is contracted, free coarser levels right after the projection, halve the flow region factor.
+// the first two do not change the partition, smaller flow regions may cost quality
+class memory_budget {
+public:
+        // resident memory of the process in bytes, 0 if it cannot be determined
+        static uint64_t resident_memory();
+
+        // bytes a run on G is projected to allocate on top of the resident memory (modes selected in config)
+        static uint64_t projected_usage(const PartitionConfig & config, graph_access & G);
+
+        // selects the cheaper modes in config until the projection of concurrent_runs runs (e.g. kaffpaE
+        // islands sharing the process) fits into the budget. returns false if even the cheapest mode does not fit
+        static bool apply(PartitionConfig & config, graph_access & G, unsigned concurrent_runs = 1);
+
+        // number of individuals of individuum_bytes each that every one of the islands can keep
+        // besides the runs of the partitioner on G
+        static unsigned affordable_individuals(const PartitionConfig & config, graph_access & G,
+                                               uint64_t individuum_bytes, unsigned islands);
+
+private:
+        static bool uses_flows(const PartitionConfig & config);
+};
+
+
+#endif /* end of include guard: MEMORY_BUDGET_T4N8WQ2E */
@@ -219,6 +219,8 @@ struct PartitionConfig
 
         unsigned mh_pool_size;
 
+        int  mh_pipeline_workers; // number of offspring that an island computes concurrently
+
         bool combine; // in this case the second index is filled and edges between both partitions are not contracted
 
         unsigned initial_partition_optimize_fm_limits;
@@ -280,6 +282,19 @@ struct PartitionConfig
 
         std::string filename_output;
 
+        // json report of the phase_timer, disabled if empty
+        std::string performance_report;
+
+        // memory budget of the partitioner in MB, 0 means no budget. if the projected peak memory
+        // exceeds it, the partitioner switches to the cheaper modes below (see memory_budget)
+        double memory_budget;
+
+        // free the edge ratings of a level once it is contracted
+        bool release_edge_ratings;
+
+        // free coarser graphs, mappings and boundaries right after the projection
+        bool release_coarse_levels;
+
         bool kaffpa_perfectly_balance;
 
         bool mode_node_separators;
@@ -380,17 +395,33 @@ struct PartitionConfig
 
 	int search_space_s;
 
+        // number of candidate swaps evaluated concurrently by the parallel local search (num_threads > 1)
+        int ls_swap_batch_size;
+
         PreConfigMapping preconfiguration_mapping;
 
         int max_recursion_levels_construction; 
 
         bool enable_mapping;
 
+        // k-way refinement minimizes the communication cost on the hierarchy instead of the cut,
+        // block i is placed on PE i
+        bool topology_aware_refinement;
+
+        //=======================================
+        //===============NODE ORDERING===========
+        //=======================================
+        
+        // subgraphs with at most this many nodes are ordered using minimum degree
+        int dissection_rec_limit;
+
         //=======================================
         //===============Shared Mem OMP==========
         //=======================================
         bool enable_omp;
 
+        int num_threads;
+
         void LogDump(FILE *out) const {
         }
 };
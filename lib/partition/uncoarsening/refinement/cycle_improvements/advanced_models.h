@@ -291,6 +291,7 @@ bool advanced_models::handle_ultra_model_conflicts( PartitionConfig & config,
                         } endfor
                 } endfor
 
+                #pragma omp atomic
                 conflicts++;
                 return true;
         } 
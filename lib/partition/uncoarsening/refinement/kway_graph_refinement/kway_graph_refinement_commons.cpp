@@ -9,10 +9,11 @@
 
 #include "kway_graph_refinement_commons.h"
 
-kway_graph_refinement_commons::kway_graph_refinement_commons( PartitionConfig & config ) {
+kway_graph_refinement_commons::kway_graph_refinement_commons( PartitionConfig & config ) : m_distances(NULL) {
         init(config);
 }
 
 kway_graph_refinement_commons::~kway_graph_refinement_commons() {
+        delete m_distances;
 }
 
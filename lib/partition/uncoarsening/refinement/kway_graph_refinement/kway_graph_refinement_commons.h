@@ -10,6 +10,7 @@
 
 #include <vector>
 
+#include "data_structure/matrix/online_distance_matrix.h"
 #include "data_structure/priority_queues/priority_queue_interface.h"
 #include "definitions.h"
 #include "random_functions.h"
@@ -41,6 +42,14 @@ class kway_graph_refinement_commons  {
                 inline unsigned getUnderlyingK();
 
         private:
+                // gain in communication cost sum_{(u,v) in E} w(u,v) * D(block(u), block(v))
+                EdgeWeight compute_topology_gain(graph_access & G, 
+                                                 NodeID & node, 
+                                                 PartitionID & max_gainer, 
+                                                 EdgeWeight & ext_degree);
+
+                // communication cost of the edges of the current node if it were placed in block 
+                inline EdgeWeight communication_cost( PartitionID block );
 
                 //for efficient computation of internal and external degrees
                 struct round_struct {
@@ -50,6 +59,10 @@ class kway_graph_refinement_commons  {
 
                 std::vector<round_struct>                    m_local_degrees;
                 unsigned                                     m_round;
+
+                // set if the refinement is topology aware, blocks are identified with PEs
+                online_distance_matrix*                      m_distances;
+                std::vector<PartitionID>                     m_adjacent_blocks;
 };
 
 inline unsigned kway_graph_refinement_commons::getUnderlyingK() {
@@ -64,6 +77,22 @@ inline void kway_graph_refinement_commons::init(PartitionConfig & config) {
         }
 
         m_round = 0;//needed for the computation of internal and external degrees
+
+        delete m_distances;
+        m_distances = NULL;
+
+        // only if the blocks correspond to the PEs of the hierarchy, i.e. not during initial bipartitioning
+        if( config.topology_aware_refinement && !config.group_sizes.empty() ) {
+                PartitionID num_pes = 1;
+                for( unsigned i = 0; i < config.group_sizes.size(); i++) {
+                        num_pes *= config.group_sizes[i];
+                }
+
+                if( num_pes == config.k ) {
+                        m_distances = new online_distance_matrix(config.k, config.k);
+                        m_distances->setPartitionConfig(config);
+                }
+        }
 }
 
 inline bool kway_graph_refinement_commons::incident_to_more_than_two_partitions(graph_access & G, NodeID & node) {
@@ -124,6 +153,10 @@ inline Gain kway_graph_refinement_commons::compute_gain(graph_access & G,
                                                         NodeID & node, 
                                                         PartitionID & max_gainer, 
                                                         EdgeWeight & ext_degree) {
+        if( m_distances != NULL ) {
+                return compute_topology_gain(G, node, max_gainer, ext_degree);
+        }
+
         //for all incident partitions compute gain
         //return max gain and max_gainer partition
         PartitionID source_partition = G.getPartitionIndex(node);
@@ -172,5 +205,68 @@ inline Gain kway_graph_refinement_commons::compute_gain(graph_access & G,
 }
 
 
+inline EdgeWeight kway_graph_refinement_commons::communication_cost( PartitionID block ) {
+        // edges inside of a block do not communicate
+        EdgeWeight cost = 0;
+        for( unsigned i = 0; i < m_adjacent_blocks.size(); i++) {
+                PartitionID other = m_adjacent_blocks[i];
+                if( other != block ) {
+                        cost += m_local_degrees[other].local_degree * m_distances->get_xy(block, other);
+                }
+        }
+        return cost;
+}
+
+inline Gain kway_graph_refinement_commons::compute_topology_gain(graph_access & G, 
+                                                                 NodeID & node, 
+                                                                 PartitionID & max_gainer, 
+                                                                 EdgeWeight & ext_degree) {
+        PartitionID source_partition = G.getPartitionIndex(node);
+        max_gainer                   = INVALID_PARTITION;
+
+        m_round++;//can become zero again
+        m_adjacent_blocks.clear();
+        forall_out_edges(G, e, node) {
+                NodeID target                = G.getEdgeTarget(e);
+                PartitionID target_partition = G.getPartitionIndex(target);
+
+                if(m_local_degrees[target_partition].round == m_round) {
+                        m_local_degrees[target_partition].local_degree += G.getEdgeWeight(e);
+                } else {
+                        m_local_degrees[target_partition].local_degree = G.getEdgeWeight(e);
+                        m_local_degrees[target_partition].round = m_round;
+                        m_adjacent_blocks.push_back(target_partition);
+                }
+        } endfor
+
+        // only adjacent blocks are candidates, as in the edge cut case
+        EdgeWeight source_cost = communication_cost(source_partition);
+        Gain max_gain          = 0;
+        for( unsigned i = 0; i < m_adjacent_blocks.size(); i++) {
+                PartitionID target_partition = m_adjacent_blocks[i];
+                if( target_partition == source_partition ) continue;
+
+                Gain gain = source_cost - communication_cost(target_partition);
+                if( max_gainer == INVALID_PARTITION || gain > max_gain ) {
+                        max_gain   = gain;
+                        max_gainer = target_partition;
+                } else if( gain == max_gain ) {
+                        //break ties randomly
+                        bool accept = random_functions::nextBool();
+                        if(accept) {
+                                max_gainer = target_partition;
+                        }
+                }
+        }
+
+        if(max_gainer != INVALID_PARTITION) {
+                ext_degree = m_local_degrees[max_gainer].local_degree;
+        } else {
+                ext_degree = 0;
+        }
+
+        return max_gain;
+}
+
 #endif /* end of include guard: KWAY_GRAPH_REFINEMENT_COMMONS_PVGY97EW */
 
@@ -11,6 +11,7 @@
 #include "data_structure/priority_queues/maxNodeHeap.h"
 #include "kway_graph_refinement_core.h"
 #include "kway_stop_rule.h"
+#include "phase_timer.h"
 #include "quality_metrics.h"
 #include "random_functions.h"
 
@@ -165,6 +166,9 @@ EdgeWeight kway_graph_refinement_core::single_kway_refinement_round_internal(Par
         ASSERT_TRUE(boundary.assert_bnodes_in_boundaries());
         ASSERT_TRUE(boundary.assert_boundaries_are_bnodes());
 
+        phase_timer* ptimer = phase_timer::getInstance();
+        if(ptimer->enabled()) ptimer->max_value("queue_bytes", queue->memory());
+
         delete queue;
         delete stopping_rule;
         return initial_cut - best_cut; 
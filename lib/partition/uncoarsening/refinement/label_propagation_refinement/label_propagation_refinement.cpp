@@ -8,6 +8,7 @@
 
 #include "label_propagation_refinement.h"
 #include "partition/coarsening/clustering/node_ordering.h"
+#include "tools/phase_timer.h"
 #include "tools/random_functions.h"
 
 label_propagation_refinement::label_propagation_refinement() {
@@ -21,6 +22,7 @@ label_propagation_refinement::~label_propagation_refinement() {
 EdgeWeight label_propagation_refinement::perform_refinement(PartitionConfig & partition_config, 
                                                             graph_access & G, 
                                                             complete_boundary & boundary) {
+        phase_scope refinement_phase("label_propagation_refinement");
         NodeWeight block_upperbound = partition_config.upper_bound_partition;
 
         // in this case the _matching paramter is not used 
@@ -9,6 +9,7 @@
 #include "kway_graph_refinement/kway_graph_refinement.h"
 #include "kway_graph_refinement/multitry_kway_fm.h"
 #include "mixed_refinement.h"
+#include "phase_timer.h"
 #include "quotient_graph_refinement/quotient_graph_refinement.h"
 
 mixed_refinement::mixed_refinement() {
@@ -32,11 +33,11 @@ EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_
                 while(sth_changed) {
                         EdgeWeight improvement = 0;
                         if(config.corner_refinement_enabled) {
-                                improvement += kway->perform_refinement(config, G, boundary);
+                                improvement += timed_refinement("kway_refinement", kway, config, G, boundary);
                         }
 
                         if(!config.quotient_graph_refinement_disabled) {
-                                improvement += refine->perform_refinement(config, G, boundary);
+                                improvement += timed_refinement("quotient_graph_refinement", refine, config, G, boundary);
                         }
 
                         overall_improvement += improvement;
@@ -45,15 +46,15 @@ EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_
 
         } else {
                 if(config.corner_refinement_enabled) {
-                        overall_improvement += kway->perform_refinement(config, G, boundary);
+                        overall_improvement += timed_refinement("kway_refinement", kway, config, G, boundary);
                 } 
 
                 if(!config.quotient_graph_refinement_disabled) {
-                        overall_improvement += refine->perform_refinement(config, G, boundary);
+                        overall_improvement += timed_refinement("quotient_graph_refinement", refine, config, G, boundary);
                 }
 
                 if(config.kaffpa_perfectly_balanced_refinement) {
-                        overall_improvement += cycle_refine->perform_refinement(config, G, boundary);
+                        overall_improvement += timed_refinement("cycle_refinement", cycle_refine, config, G, boundary);
                 }
         }
 
@@ -65,3 +66,12 @@ EdgeWeight mixed_refinement::perform_refinement(PartitionConfig & config, graph_
         return overall_improvement;
 }
 
+EdgeWeight mixed_refinement::timed_refinement(const std::string & name, refinement* refine, PartitionConfig & config,
+                                              graph_access & G, complete_boundary & boundary) {
+        phase_scope refinement_phase(name);
+        EdgeWeight improvement = refine->perform_refinement(config, G, boundary);
+        phase_timer::getInstance()->add_value("cut_improvement", improvement);
+
+        return improvement;
+}
+
@@ -8,6 +8,8 @@
 #ifndef MIXED_REFINEMENT_XJC6COP3
 #define MIXED_REFINEMENT_XJC6COP3
 
+#include <string>
+
 #include "definitions.h"
 #include "refinement.h"
 
@@ -19,6 +21,11 @@ public:
         virtual EdgeWeight perform_refinement(PartitionConfig & config, 
                                               graph_access & G, 
                                               complete_boundary & boundary); 
+
+private:
+        // runs the refinement algorithm as a phase of the phase_timer
+        EdgeWeight timed_refinement(const std::string & name, refinement* refine, PartitionConfig & config,
+                                    graph_access & G, complete_boundary & boundary);
 };
 
 
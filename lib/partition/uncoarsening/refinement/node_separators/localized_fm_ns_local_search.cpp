@@ -54,7 +54,6 @@ EdgeWeight localized_fm_ns_local_search::perform_refinement(const PartitionConfi
 EdgeWeight localized_fm_ns_local_search::perform_refinement(const PartitionConfig & config, graph_access & G, 
                                                             bool balance, PartitionID to) {
 
-        std::vector< bool > moved_out_of_separator(G.number_of_nodes(), false);
         std::vector< NodeID > start_nodes;
         forall_nodes(G, node) {
                 if( G.getPartitionIndex(node) == 2 ) {
@@ -63,6 +62,14 @@ EdgeWeight localized_fm_ns_local_search::perform_refinement(const PartitionConfi
         } endfor
         random_functions::permutate_vector_good(start_nodes, false);
 
+        return perform_refinement(config, G, start_nodes, balance, to);
+}
+
+EdgeWeight localized_fm_ns_local_search::perform_refinement(const PartitionConfig & config, graph_access & G, 
+                                                            std::vector< NodeID > & start_nodes,
+                                                            bool balance, PartitionID to) {
+
+        std::vector< bool > moved_out_of_separator(G.number_of_nodes(), false);
         EdgeWeight improvement = 0;
         while( start_nodes.size() > 0 ) {
                 std::vector< NodeID > real_start_nodes;
@@ -17,6 +17,9 @@ public:
         virtual ~localized_fm_ns_local_search();
 
         EdgeWeight perform_refinement(const PartitionConfig & config, graph_access & G, bool balance = false, PartitionID to = 4);
+        // only uses the given separator nodes as seeds (start_nodes is consumed)
+        EdgeWeight perform_refinement(const PartitionConfig & config, graph_access & G, std::vector< NodeID > & start_nodes, 
+                                      bool balance = false, PartitionID to = 4);
         EdgeWeight perform_refinement(const PartitionConfig & config, graph_access & G, std::vector< NodeWeight > & block_weight, 
                                       std::vector< bool > & moved_out_of_separator,
                                       PartialBoundary & separator, bool balance = false, PartitionID to = 4);
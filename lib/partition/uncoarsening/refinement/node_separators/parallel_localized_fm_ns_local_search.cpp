@@ -0,0 +1,124 @@
+//
+// Author: Christian Schulz <christian.schulz.phone@gmail.com>
+// 
+
+#include <algorithm>
+#include <omp.h>
+
+#include "localized_fm_ns_local_search.h"
+#include "parallel_localized_fm_ns_local_search.h"
+#include "tools/random_functions.h"
+
+parallel_localized_fm_ns_local_search::parallel_localized_fm_ns_local_search(const PartitionConfig & config, graph_access & G) {
+        m_local_graphs.resize(std::max(1, config.num_threads));
+        #pragma omp parallel for num_threads(m_local_graphs.size())
+        for( int t = 0; t < (int)m_local_graphs.size(); t++) {
+                m_local_graphs[t] = new graph_access();
+                m_local_graphs[t]->share_graph(G);
+        }
+}
+
+parallel_localized_fm_ns_local_search::~parallel_localized_fm_ns_local_search() {
+        for( unsigned t = 0; t < m_local_graphs.size(); t++) {
+                delete m_local_graphs[t];
+        }
+}
+
+EdgeWeight parallel_localized_fm_ns_local_search::perform_refinement(const PartitionConfig & config, graph_access & G, 
+                                                                     bool balance, PartitionID to) {
+        std::vector< NodeID > separator;
+        std::vector< NodeWeight > block_weights(3,0);
+        forall_nodes(G, node) {
+                PartitionID block = std::min(G.getPartitionIndex(node), (PartitionID)2);
+                block_weights[block] += G.getNodeWeight(node);
+                if( block == 2 ) {
+                        separator.push_back(node);
+                }
+        } endfor
+        if( separator.empty() ) return 0;
+
+        random_functions::permutate_vector_good(separator, false);
+
+        int num_threads = std::min((int)m_local_graphs.size(), (int)separator.size());
+        std::vector< std::vector< NodeID > > start_nodes(num_threads);
+        for( unsigned i = 0; i < separator.size(); i++) {
+                start_nodes[i % num_threads].push_back(separator[i]);
+        }
+
+        std::vector< int > seeds(num_threads);
+        for( int t = 0; t < num_threads; t++) {
+                seeds[t] = random_functions::nextInt(0, std::numeric_limits<int>::max());
+        }
+        int continuation_seed = random_functions::nextInt(0, std::numeric_limits<int>::max());
+
+        std::vector< std::vector< NodeID > > changed_nodes(num_threads);
+        std::vector< std::vector< int > > weight_delta(num_threads, std::vector< int >(3,0));
+
+        #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+        for( int t = 0; t < num_threads; t++) {
+                random_functions::setSeed(seeds[t]);
+                graph_access & local_G = *m_local_graphs[t];
+                forall_nodes(G, node) {
+                        local_G.setPartitionIndex(node, G.getPartitionIndex(node));
+                } endfor
+
+                localized_fm_ns_local_search fmnsls;
+                fmnsls.perform_refinement(config, local_G, start_nodes[t], balance, to);
+
+                forall_nodes(G, node) {
+                        PartitionID old_block = G.getPartitionIndex(node);
+                        PartitionID new_block = local_G.getPartitionIndex(node);
+                        if( old_block != new_block ) {
+                                changed_nodes[t].push_back(node);
+                                weight_delta[t][old_block] -= G.getNodeWeight(node);
+                                weight_delta[t][new_block] += G.getNodeWeight(node);
+                        }
+                } endfor
+        }
+
+        random_functions::setSeed(continuation_seed);
+
+        // merge: best improvements first
+        std::vector< int > order(num_threads);
+        for( int t = 0; t < num_threads; t++) order[t] = t;
+        std::stable_sort(order.begin(), order.end(), [&](const int & lhs, const int & rhs) {
+                        return weight_delta[lhs][2] < weight_delta[rhs][2];
+        });
+
+        NodeWeight input_separator = block_weights[2];
+        std::vector< bool > blocked(G.number_of_nodes(), false);
+        for( int t : order ) {
+                if( weight_delta[t][2] >= 0 ) break;
+
+                bool conflict = false;
+                for( NodeID node : changed_nodes[t] ) {
+                        if( blocked[node] ) {
+                                conflict = true;
+                                break;
+                        }
+                }
+                if( conflict ) continue;
+
+                bool feasible = true;
+                for( PartitionID block = 0; block < 2; block++) {
+                        NodeWeight new_weight = block_weights[block] + weight_delta[t][block];
+                        if( weight_delta[t][block] > 0 && new_weight >= config.upper_bound_partition ) {
+                                feasible = false;
+                        }
+                }
+                if( !feasible ) continue;
+
+                for( NodeID node : changed_nodes[t] ) {
+                        G.setPartitionIndex(node, m_local_graphs[t]->getPartitionIndex(node));
+                        blocked[node] = true;
+                        forall_out_edges(G, e, node) {
+                                blocked[G.getEdgeTarget(e)] = true;
+                        } endfor
+                }
+                for( PartitionID block = 0; block < 3; block++) {
+                        block_weights[block] += weight_delta[t][block];
+                }
+        }
+
+        return input_separator - block_weights[2];
+}
@@ -0,0 +1,34 @@
+//
+// Author: Christian Schulz <christian.schulz.phone@gmail.com>
+// 
+
+#ifndef PARALLEL_LOCALIZED_FM_NS_LOCAL_SEARCH_K3QZ8T1M
+#define PARALLEL_LOCALIZED_FM_NS_LOCAL_SEARCH_K3QZ8T1M
+
+#include <vector>
+
+#include "definitions.h"
+#include "partition_config.h"
+#include "data_structure/graph_access.h"
+
+// runs localized fm searches concurrently on views of the graph, i.e. the threads share the
+// read-only topology and only have a private partition.
+// the separator nodes are distributed round robin to the threads (disjoint seeds).
+// afterwards the improvements of the threads are merged: a thread result is applied 
+// if it does not touch a node that has been changed (or is adjacent to a node changed) 
+// by an already applied thread result and if it does not violate the balance constraint.
+// hence the merged result is always a valid separator.
+class parallel_localized_fm_ns_local_search {
+public:
+        // creates config.num_threads views of G, G has to outlive the object
+        parallel_localized_fm_ns_local_search(const PartitionConfig & config, graph_access & G);
+        virtual ~parallel_localized_fm_ns_local_search();
+
+        EdgeWeight perform_refinement(const PartitionConfig & config, graph_access & G, bool balance = false, PartitionID to = 4);
+
+private:
+        std::vector< graph_access* > m_local_graphs;
+};
+
+
+#endif /* end of include guard: PARALLEL_LOCALIZED_FM_NS_LOCAL_SEARCH_K3QZ8T1M */
@@ -9,6 +9,7 @@
 #include "data_structure/priority_queues/maxNodeHeap.h"
 #include "macros_assertions.h"
 #include "partition_accept_rule.h"
+#include "phase_timer.h"
 #include "queue_selection_strategie.h"
 #include "random_functions.h"
 #include "search_stop_rule.h"
@@ -206,6 +207,9 @@ EdgeWeight two_way_fm::perform_refinement(PartitionConfig & cfg,
         boundary.setBlockWeight(pair->lhs, lhs_part_weight);
         boundary.setBlockWeight(pair->rhs, rhs_part_weight);
 
+        phase_timer* ptimer = phase_timer::getInstance();
+        if(ptimer->enabled()) ptimer->max_value("queue_bytes", lhs_queue->memory() + rhs_queue->memory());
+
         delete lhs_queue;
         delete rhs_queue;
         delete topgain_queue_select;
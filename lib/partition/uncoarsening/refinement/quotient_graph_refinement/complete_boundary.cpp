@@ -105,3 +105,21 @@ void complete_boundary::balance_singletons(const PartitionConfig & config, graph
                 }
         }
 }
+
+uint64_t complete_boundary::memory() {
+        uint64_t bytes = sizeof(complete_boundary)
+                       + m_block_infos.capacity() * sizeof(block_informations)
+                       + m_singletons.capacity()  * sizeof(NodeID)
+                       + m_pairs.bucket_count()   * sizeof(void*);
+
+        for( block_pairs::iterator it = m_pairs.begin(); it != m_pairs.end(); ++it) {
+                bytes += sizeof(block_pairs::value_type) + 2*sizeof(void*);
+                bytes += it->second.pb_lhs.memory();
+                bytes += it->second.pb_rhs.memory();
+        }
+
+        if(Q.graphref != NULL) {
+                bytes += Q.memory() - sizeof(graph_access);
+        }
+        return bytes;
+}
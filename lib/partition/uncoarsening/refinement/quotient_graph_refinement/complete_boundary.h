@@ -65,6 +65,9 @@ class complete_boundary {
                 inline void getUnderlyingQuotientGraph( graph_access & qgraph );
                 inline void getNeighbors(PartitionID & block, std::vector<PartitionID> & neighbors);
 
+                // bytes held by the boundaries of all block pairs, the block informations and the quotient graph
+                uint64_t memory();
+
         private:
                 //updates lazy values that the access functions need
                 inline void update_lazy_values(boundary_pair * pair);
@@ -370,10 +373,11 @@ inline void complete_boundary::get_max_norm() {
 inline void complete_boundary::getUnderlyingQuotientGraph( graph_access & Q_bar ) {
          basicGraph * graphref = new basicGraph; 
          
-         if(Q_bar.graphref != NULL) {
+         if(Q_bar.graphref != NULL && Q_bar.m_owns_graph) {
                 delete Q_bar.graphref;
          }
-         Q_bar.graphref = graphref;
+         Q_bar.graphref     = graphref;
+         Q_bar.m_owns_graph = true;
  
          std::vector< std::vector< std::pair<PartitionID, EdgeWeight> > >  building_tool;
          building_tool.resize(m_block_infos.size());
@@ -90,12 +90,12 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
         std::vector<NodeID>  outer_lhs_boundary;
         std::vector<NodeID>  outer_rhs_boundary;
 
-        regions_no_edges(G, lhs_boundary_stripe, rhs_boundary_stripe, 
-                         lhs, rhs, outer_lhs_boundary, outer_rhs_boundary);
+        EdgeID no_edges = regions_no_edges(G, lhs_boundary_stripe, rhs_boundary_stripe, 
+                                           lhs, rhs, outer_lhs_boundary, outer_rhs_boundary);
         
         if(outer_lhs_boundary.size() == 0 || outer_rhs_boundary.size() == 0) return false;
         NodeID n = lhs_boundary_stripe.size() + rhs_boundary_stripe.size() + 2; //+source and target
-        fG.start_construction(n);
+        fG.start_construction(n, no_edges + outer_lhs_boundary.size() + outer_rhs_boundary.size());
 
         NodeID source = n-2;
         NodeID sink   = n-1;
@@ -137,6 +137,7 @@ EdgeWeight cut_flow_problem_solver::convert_ds( const PartitionConfig & config,
                 fG.new_edge(sourceID, sink, max_capacity);
         }
 
+        fG.finish_construction();
         return true;
 }
 
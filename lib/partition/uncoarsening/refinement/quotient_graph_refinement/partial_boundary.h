@@ -8,6 +8,7 @@
 #ifndef PARTIAL_BOUNDARY_963CRO9F_
 #define PARTIAL_BOUNDARY_963CRO9F_
 
+#include <stdint.h>
 #include <unordered_map>
 #include "definitions.h"
 
@@ -45,6 +46,10 @@ class PartialBoundary {
                 void deleteNode(NodeID node);
                 NodeID size();
 
+                // bytes held by the hash table: one allocation per node (value and next pointer,
+                // plus the allocator header) and the bucket array
+                uint64_t memory();
+
                 is_boundary_node_hashtable internal_boundary;
 };
 
@@ -68,6 +73,11 @@ inline void PartialBoundary::clear() {
         return internal_boundary.clear();
 }
 
+inline uint64_t PartialBoundary::memory() {
+        return internal_boundary.size()         * (sizeof(is_boundary_node_hashtable::value_type) + 2*sizeof(void*))
+             + internal_boundary.bucket_count() * sizeof(void*);
+}
+
 
 
 //iterator for
@@ -32,6 +32,10 @@ class area_bfs {
 				}
 			}
 
+			if( m_deepth.size() < G.number_of_nodes() ) {
+				m_deepth.resize(G.number_of_nodes(), 0);
+			}
+
 			round++; std::queue<NodeID> node_queue;
 
 			random_functions::permutate_vector_good(input_separator, false);
@@ -79,8 +83,9 @@ class area_bfs {
 			}
 		}
 
-		static std::vector<int> m_deepth;
-		static int round;
+		// thread local so that separators can be computed concurrently
+		static thread_local std::vector<int> m_deepth;
+		static thread_local int round;
 
 };
 
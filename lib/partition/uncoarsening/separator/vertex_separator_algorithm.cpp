@@ -134,7 +134,13 @@ void vertex_separator_algorithm::build_flow_problem(const PartitionConfig & conf
         source = n-2;
         sink   = n-1;
         FlowType infinite = std::numeric_limits<FlowType>::max()/2;
-        rG.start_construction(n, 0);
+
+        // upper bound on the number of edges in the flow problem (used to size the construction buffer)
+        EdgeID no_edges = outer_lhs_boundary_nodes.size() + outer_rhs_boundary_nodes.size() + (n-2)/2;
+        for( NodeID v = 0; v < n-2; v+=2) {
+                no_edges += G.getNodeDegree(forward_mapping[v]);
+        }
+        rG.start_construction(n, no_edges);
 
         for( NodeID v : outer_lhs_boundary_nodes) {
                 rG.new_edge(source, backward_mapping[v], infinite);
@@ -113,7 +113,7 @@ bool vertex_separator_flow_solver::build_flow_pb( const PartitionConfig & config
         idx = 0;
         FlowType max_capacity = std::numeric_limits<FlowType>::max();
 
-        fG.start_construction(n);
+        fG.start_construction(n, no_edges + lhs_nodes.size() + rhs_nodes.size());
         //insert directed edges from L to R
         for( unsigned i = 0; i < lhs_nodes.size(); i++, idx++) {
                 NodeID node = lhs_nodes[i];
@@ -137,6 +137,7 @@ bool vertex_separator_flow_solver::build_flow_pb( const PartitionConfig & config
                 fG.new_edge(sourceID, sink, G.getNodeWeight(rhs_nodes[i]));
         }
 
+        fG.finish_construction();
         return true;
 }
 
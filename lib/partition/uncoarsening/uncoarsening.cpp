@@ -7,11 +7,13 @@
 
 #include "graph_partition_assertions.h"
 #include "misc.h"
+#include "phase_timer.h"
 #include "quality_metrics.h"
 #include "refinement/mixed_refinement.h"
 #include "refinement/node_separators/greedy_ns_local_search.h"
 #include "refinement/node_separators/fm_ns_local_search.h"
 #include "refinement/node_separators/localized_fm_ns_local_search.h"
+#include "refinement/node_separators/parallel_localized_fm_ns_local_search.h"
 #include "refinement/label_propagation_refinement/label_propagation_refinement.h"
 #include "refinement/refinement.h"
 #include "separator/vertex_separator_algorithm.h"
@@ -41,6 +43,8 @@ int uncoarsening::perform_uncoarsening(const PartitionConfig & config, graph_hie
 }
 
 int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph_hierarchy & hierarchy) {
+        phase_scope uncoarsening_phase("uncoarsening");
+        phase_timer* ptimer = phase_timer::getInstance();
         int improvement = 0;
 
         PartitionConfig cfg     = config;
@@ -55,15 +59,22 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
         graph_access * coarsest = hierarchy.get_coarsest();
         PRINT(std::cout << "log>" << "unrolling graph with " << coarsest->number_of_nodes() << std::endl;)
 
+        ptimer->begin("level " + std::to_string(hierarchy.size() - 1));
+        ptimer->set_value("nodes", coarsest->number_of_nodes());
+        ptimer->set_value("edges", coarsest->number_of_edges());
+
         complete_boundary* finer_boundary   = NULL;
         complete_boundary* coarser_boundary = NULL;
         if(!config.label_propagation_refinement) {
+                phase_scope boundary_phase("boundary");
                 coarser_boundary = new complete_boundary(coarsest);
                 coarser_boundary->build();
+                if(ptimer->enabled()) ptimer->set_value("bytes", coarser_boundary->memory());
         }
         double factor = config.balance_factor;
         cfg.upper_bound_partition = ((!hierarchy.isEmpty()) * factor +1.0)*config.upper_bound_partition;
         improvement += (int)refine->perform_refinement(cfg, *coarsest, *coarser_boundary);
+        ptimer->end();
 
         NodeID coarser_no_nodes = coarsest->number_of_nodes();
         graph_access* finest    = NULL;
@@ -71,13 +82,35 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
         unsigned int hierarchy_deepth = hierarchy.size();
 
         while(!hierarchy.isEmpty()) {
+                ptimer->begin("projection");
                 graph_access* G = hierarchy.pop_finer_and_project();
+                ptimer->end();
 
                 PRINT(std::cout << "log>" << "unrolling graph with " << G->number_of_nodes()<<  std::endl;)
+
+                ptimer->begin("level " + std::to_string(hierarchy.size()));
+                ptimer->set_value("nodes", G->number_of_nodes());
+                ptimer->set_value("edges", G->number_of_edges());
                 
                 if(!config.label_propagation_refinement) {
+                        phase_scope boundary_phase("boundary");
                         finer_boundary = new complete_boundary(G); 
                         finer_boundary->build_from_coarser(coarser_boundary, coarser_no_nodes, hierarchy.get_mapping_of_current_finer());
+                        if(ptimer->enabled()) ptimer->set_value("bytes", finer_boundary->memory());
+                }
+
+                if(config.release_coarse_levels) {
+                        // the coarser level, its boundary and the mapping are not needed once the
+                        // finer boundary is built (the coarser boundary refers to the coarser graph)
+                        if(!config.label_propagation_refinement) {
+                                delete coarser_boundary;
+                                coarser_boundary = NULL;
+                        }
+                        hierarchy.release_mapping_of_current_finer();
+                        delete to_delete;
+                        to_delete = NULL;
+                        delete coarsest;
+                        coarsest  = NULL;
                 }
 
                 //call refinement
@@ -90,6 +123,7 @@ int uncoarsening::perform_uncoarsening_cut(const PartitionConfig & config, graph
                 if(config.use_balance_singletons && !config.label_propagation_refinement) {
                         finer_boundary->balance_singletons( config, *G );
                 }
+                ptimer->end();
 
                 // update boundary pointers
                 if(!config.label_propagation_refinement) delete coarser_boundary;
@@ -173,7 +207,16 @@ int uncoarsening::perform_uncoarsening_nodeseparator(const PartitionConfig & con
                         }
                 }
 
-                if( !config.sep_loc_fm_disabled) {
+                if( !config.sep_loc_fm_disabled && config.num_threads > 1) {
+                        parallel_localized_fm_ns_local_search fmnsls(config, (*G));
+                        for( int i = 0; i < config.sep_num_loc_fm_reps; i++) {
+                                fmnsls.perform_refinement(config, (*G));
+
+                                int rnd_block = random_functions::nextInt(0,1);
+                                fmnsls.perform_refinement(config, (*G), true, rnd_block);
+                                fmnsls.perform_refinement(config, (*G), true, rnd_block == 0? 1 : 0);
+                        }
+                } else if( !config.sep_loc_fm_disabled) {
                         for( int i = 0; i < config.sep_num_loc_fm_reps; i++) {
                                 localized_fm_ns_local_search fmnsls;
                                 fmnsls.perform_refinement(config, (*G));
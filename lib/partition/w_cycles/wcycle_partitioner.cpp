@@ -16,6 +16,7 @@
 #include "graph_partition_assertions.h"
 #include "initial_partitioning/initial_partitioning.h"
 #include "misc.h"
+#include "phase_timer.h"
 #include "random_functions.h"
 #include "uncoarsening/refinement/mixed_refinement.h"
 #include "uncoarsening/refinement/label_propagation_refinement/label_propagation_refinement.h"
@@ -49,6 +50,11 @@ int wcycle_partitioner::perform_partitioning_recursive( PartitionConfig & partit
         //      initial partitioning
         //
         //refinement
+        phase_scope level_phase("level " + std::to_string(m_level));
+        phase_timer* ptimer = phase_timer::getInstance();
+        ptimer->set_value("nodes", G.number_of_nodes());
+        ptimer->set_value("edges", G.number_of_edges());
+
         NodeID no_of_coarser_vertices = G.number_of_nodes();
         NodeID no_of_finer_vertices   = G.number_of_nodes();
         int improvement = 0;
@@ -68,11 +74,16 @@ int wcycle_partitioner::perform_partitioning_recursive( PartitionConfig & partit
         coarsening_configurator coarsening_config;
         coarsening_config.configure_coarsening(partition_config, &edge_matcher, m_level);
         
+        ptimer->begin("rating");
         rating.rate(*finer, m_level);
+        ptimer->end();
 
+        ptimer->begin("matching");
         edge_matcher->match(partition_config, *finer, edge_matching, *coarse_mapping, no_of_coarser_vertices, permutation);
+        ptimer->end();
         delete edge_matcher; 
 
+        ptimer->begin("contraction");
         if(partition_config.graph_allready_partitioned) {
                 contracter->contract_partitioned(partition_config, *finer, 
                                                  *coarser, edge_matching, 
@@ -84,6 +95,10 @@ int wcycle_partitioner::perform_partitioning_recursive( PartitionConfig & partit
                                      *coarse_mapping, no_of_coarser_vertices, 
                                      permutation);
         }
+        if(partition_config.release_edge_ratings) {
+                finer->release_edge_ratings();
+        }
+        ptimer->end();
 
         coarser->set_partition_count(partition_config.k);
         complete_boundary* coarser_boundary =  NULL;
@@ -5,72 +5,30 @@
  * Author: Daniel Seemaier <daniel.seemaier@student.kit.edu>
  * Christian Schulz <christian.schulz.phone@gmail.com>
  *****************************************************************************/
+#include <algorithm>
+#include <limits>
+
 #include "spac.h"
+#include "tools/random_functions.h"
 
 spac::spac(graph_access &input_graph, EdgeWeight infinity)
-        : m_input_graph(input_graph),  m_split_graph(), m_infinity(infinity), m_reverse_edge() {
+        : m_input_graph(input_graph),  m_split_graph(), m_view(input_graph, infinity), m_coarse_mapping(), m_coarse_split_graph() {
 }
 
 graph_access &spac::construct_split_graph() {
-    find_reverse_edges();
-
-    // find number of degree 1 and 2 vertices
-    NodeID number_of_deg1_vertices = 0;
-    NodeID number_of_deg2_vertices = 0;
-    for (NodeID v = 0; v < m_input_graph.number_of_nodes(); ++v) {
-        //NodeID deg = m_input_graph.getNodeDegree(v);
-
-        if (m_input_graph.getNodeDegree(v) == 1) {
-            ++number_of_deg1_vertices;
-        } else if (m_input_graph.getNodeDegree(v) == 2) {
-            ++number_of_deg2_vertices;
-        }
-    }
-
-    // calculation of the dimension of the split graph
-    NodeID split_n = m_input_graph.number_of_edges(); // two times the number of edges
-    EdgeID split_m = 3 * m_input_graph.number_of_edges() - 2 * (number_of_deg1_vertices + number_of_deg2_vertices);
-    m_split_graph.start_construction(split_n, split_m);
+    m_split_graph.start_construction(m_view.number_of_nodes(), m_view.number_of_edges());
 
     for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
-        NodeID deg = m_input_graph.getNodeDegree(u);
+        unsigned deg = m_view.degree(u);
 
         for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
-            EdgeID nth_edge_at_u = (e - m_input_graph.get_first_edge(u));
-
             NodeID split_node = m_split_graph.new_node();
             assert(e == split_node);
             m_split_graph.setNodeWeight(split_node, 1);
 
-            EdgeID dominant_edge = m_split_graph.new_edge(split_node, m_reverse_edge[e]);
-            m_split_graph.setEdgeWeight(dominant_edge, m_infinity);
-
-            if (deg == 2) {
-                EdgeID auxiliary_edge;
-                if (nth_edge_at_u == 0) { // split split vertex
-                    auxiliary_edge = m_split_graph.new_edge(split_node, split_node + 1);
-                } else { // second split vertex
-                    assert(e + 1 == m_input_graph.get_first_invalid_edge(u));
-                    assert(split_node > 0);
-
-                    auxiliary_edge = m_split_graph.new_edge(split_node, split_node - 1);
-                }
-                m_split_graph.setEdgeWeight(auxiliary_edge, 1);
-            } else if (deg > 2) {
-                // calculate offsets between split_node and the next / prev node in the cycle
-                int prev_offset = -1;
-                int next_offset = 1;
-                if (nth_edge_at_u == 0) {
-                    prev_offset = deg - 1;
-                } else if (nth_edge_at_u == deg - 1) {
-                    next_offset = -(deg - 1);
-                }
-
-                m_split_graph.setEdgeWeight(m_split_graph.new_edge(split_node, split_node + prev_offset), 1);
-                m_split_graph.setEdgeWeight(m_split_graph.new_edge(split_node, split_node + next_offset), 1);
-            } else {
-                // nothing to do for leaves
-                assert(deg == 1);
+            for (unsigned i = 0; i < deg; ++i) {
+                EdgeID split_edge = m_split_graph.new_edge(split_node, m_view.target(u, split_node, i));
+                m_split_graph.setEdgeWeight(split_edge, m_view.weight(i));
             }
         }
     }
@@ -89,53 +47,121 @@ graph_access &spac::construct_split_graph() {
     return m_split_graph;
 }
 
-void spac::fix_cut_dominant_edges() {
-    EdgeID number_of_bad_edges = 0;
+graph_access &spac::construct_coarse_split_graph(NodeWeight cluster_upper_bound, unsigned iterations) {
+    NodeID n = m_view.number_of_nodes();
+    std::vector<NodeID> &cluster_id = m_coarse_mapping;
+    std::vector<NodeWeight> cluster_sizes(n, 0);
+    cluster_id.resize(n);
+    for (NodeID split_node = 0; split_node < n; ++split_node) {
+        cluster_id[split_node] = std::min<NodeID>(split_node, m_view.dominant_neighbor(split_node));
+        ++cluster_sizes[cluster_id[split_node]];
+    }
 
-    // check if there are bad edges, i.e. dominant edges with endpoints in different blocks
-    for (NodeID u = 0; u < m_split_graph.number_of_nodes(); ++u) {
-        for (EdgeID e = m_split_graph.get_first_edge(u); e < m_split_graph.get_first_invalid_edge(u); ++e) {
-            NodeID v = m_split_graph.getEdgeTarget(e);
+    // same rules as size_constraint_label_propagation, the nodes are the input edges with weight two
+    for (unsigned j = 0; j < iterations; ++j) {
+        for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+            for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+                EdgeID reverse = m_view.dominant_neighbor(e);
+                if (reverse < e) continue;
+
+                NodeID clusters[4];
+                unsigned number_of_clusters = auxiliary_labels(cluster_id, u, e, clusters);
+
+                NodeID my_cluster = cluster_id[e];
+                NodeID max_cluster = my_cluster;
+                unsigned max_value = 0;
+                for (unsigned i = 0; i < number_of_clusters; ++i) {
+                    NodeID cur_cluster = clusters[i];
+                    unsigned cur_value = 0;
+                    for (unsigned l = 0; l < number_of_clusters; ++l) {
+                        if (clusters[l] == cur_cluster) ++cur_value;
+                    }
 
-            PartitionID u_part = m_split_graph.getPartitionIndex(u);
-            PartitionID v_part = m_split_graph.getPartitionIndex(v);
+                    if ((cur_value > max_value || (cur_value == max_value && random_functions::nextBool()))
+                        && (cluster_sizes[cur_cluster] + 2 < cluster_upper_bound || cur_cluster == my_cluster)) {
+                        max_value = cur_value;
+                        max_cluster = cur_cluster;
+                    }
+                }
 
-            if (m_split_graph.getEdgeWeight(e) > 1 && u_part != v_part) {
-                ++number_of_bad_edges;
+                cluster_sizes[my_cluster] -= 2;
+                cluster_sizes[max_cluster] += 2;
+                cluster_id[e] = max_cluster;
+                cluster_id[reverse] = max_cluster;
             }
         }
     }
 
-    // if there are bad edges, fix them
-    if (number_of_bad_edges > 0) {
-        std::vector<NodeID> partition_sizes(m_split_graph.get_partition_count());
-        for (NodeID u = 0; u < m_split_graph.number_of_nodes(); ++u) {
-            ++partition_sizes[m_split_graph.getPartitionIndex(u)];
+    // remap the cluster ids to 0, ..., number_of_clusters-1, cluster_sizes is reused for the new ids
+    const NodeWeight unassigned = std::numeric_limits<NodeWeight>::max();
+    std::vector<NodeWeight> &remap = cluster_sizes;
+    std::fill(remap.begin(), remap.end(), unassigned);
+    NodeID number_of_clusters = 0;
+    for (NodeID split_node = 0; split_node < n; ++split_node) {
+        if (remap[cluster_id[split_node]] == unassigned) {
+            remap[cluster_id[split_node]] = number_of_clusters++;
         }
+        cluster_id[split_node] = remap[cluster_id[split_node]];
+    }
+    std::vector<NodeWeight>().swap(cluster_sizes);
 
-        for (NodeID u = 0; u < m_split_graph.number_of_nodes(); ++u) {
-            for (EdgeID e = m_split_graph.get_first_edge(u); e < m_split_graph.get_first_invalid_edge(u); ++e) {
-                NodeID v = m_split_graph.getEdgeTarget(e);
-
-                PartitionID u_part = m_split_graph.getPartitionIndex(u);
-                PartitionID v_part = m_split_graph.getPartitionIndex(v);
-
-                // move one endpoint to the smaller partition
-                if (m_split_graph.getEdgeWeight(e) > 1 && u_part != v_part) {
-                    if (partition_sizes[u_part] < partition_sizes[v_part]) {
-                        ++partition_sizes[u_part];
-                        --partition_sizes[v_part];
-                        m_split_graph.setPartitionIndex(v, u_part);
-                    } else {
-                        --partition_sizes[u_part];
-                        ++partition_sizes[v_part];
-                        m_split_graph.setPartitionIndex(u, v_part);
-                    }
-                }
+    // members of the clusters, sorted by cluster
+    std::vector<EdgeID> member_start(number_of_clusters + 1, 0);
+    for (NodeID split_node = 0; split_node < n; ++split_node) {
+        ++member_start[cluster_id[split_node] + 1];
+    }
+    for (NodeID cluster = 0; cluster < number_of_clusters; ++cluster) {
+        member_start[cluster + 1] += member_start[cluster];
+    }
+    std::vector<NodeID> members(n);
+    std::vector<EdgeID> position(member_start.begin(), member_start.end() - 1);
+    for (NodeID split_node = 0; split_node < n; ++split_node) {
+        members[position[cluster_id[split_node]]++] = split_node;
+    }
+    std::vector<EdgeID>().swap(position);
+
+    // aggregate the edges between clusters
+    std::vector<EdgeID> coarse_edge_start(number_of_clusters + 1, 0);
+    std::vector<NodeID> coarse_targets;
+    std::vector<EdgeWeight> coarse_weights;
+    std::vector<EdgeWeight> rating(number_of_clusters, 0);
+    std::vector<NodeID> touched;
+    for (NodeID cluster = 0; cluster < number_of_clusters; ++cluster) {
+        for (EdgeID pos = member_start[cluster]; pos < member_start[cluster + 1]; ++pos) {
+            NodeID split_node = members[pos];
+            NodeID u = m_input_graph.getEdgeTarget(m_view.dominant_neighbor(split_node));
+            unsigned deg = m_view.degree(u);
+
+            for (unsigned i = 0; i < deg; ++i) {
+                NodeID target_cluster = cluster_id[m_view.target(u, split_node, i)];
+                if (target_cluster == cluster) continue;
+                if (rating[target_cluster] == 0) touched.push_back(target_cluster);
+                rating[target_cluster] += m_view.weight(i);
             }
         }
 
+        for (unsigned i = 0; i < touched.size(); ++i) {
+            coarse_targets.push_back(touched[i]);
+            coarse_weights.push_back(rating[touched[i]]);
+            rating[touched[i]] = 0;
+        }
+        touched.clear();
+        coarse_edge_start[cluster + 1] = coarse_targets.size();
     }
+
+    m_coarse_split_graph.start_construction(number_of_clusters, coarse_targets.size());
+    for (NodeID cluster = 0; cluster < number_of_clusters; ++cluster) {
+        NodeID coarse_node = m_coarse_split_graph.new_node();
+        m_coarse_split_graph.setNodeWeight(coarse_node, member_start[cluster + 1] - member_start[cluster]);
+
+        for (EdgeID e = coarse_edge_start[cluster]; e < coarse_edge_start[cluster + 1]; ++e) {
+            EdgeID coarse_edge = m_coarse_split_graph.new_edge(coarse_node, coarse_targets[e]);
+            m_coarse_split_graph.setEdgeWeight(coarse_edge, coarse_weights[e]);
+        }
+    }
+    m_coarse_split_graph.finish_construction();
+
+    return m_coarse_split_graph;
 }
 
 std::vector<PartitionID> spac::project_partition() {
@@ -143,19 +169,117 @@ std::vector<PartitionID> spac::project_partition() {
 
     for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
         for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
-            edge_partition[e] = m_split_graph.getPartitionIndex(e);
+            if (m_coarse_mapping.empty()) {
+                edge_partition[e] = m_split_graph.getPartitionIndex(e);
+            } else {
+                edge_partition[e] = m_coarse_split_graph.getPartitionIndex(m_coarse_mapping[e]);
+            }
         }
     }
 
     return edge_partition;
 }
 
-unsigned spac::calculate_vertex_cut(const std::vector<PartitionID> &edge_partition) {
+void spac::refine_edge_partition(std::vector<PartitionID> &edge_partition, PartitionID k, NodeWeight upper_bound, unsigned iterations) {
+    std::vector<NodeWeight> block_weights(k, 0);
+    for (EdgeID e = 0; e < edge_partition.size(); ++e) {
+        ++block_weights[edge_partition[e]];
+    }
+
+    for (unsigned j = 0; j < iterations; ++j) {
+        EdgeID change_counter = 0;
+        for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+            for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+                EdgeID reverse = m_view.dominant_neighbor(e);
+                if (reverse < e) continue;
+
+                // blocks of the other edges of u and v
+                PartitionID blocks[4];
+                unsigned number_of_blocks = auxiliary_labels(edge_partition, u, e, blocks);
+
+                PartitionID my_block = edge_partition[e];
+                PartitionID max_block = my_block;
+                unsigned max_value = 0;
+                for (unsigned i = 0; i < number_of_blocks; ++i) {
+                    if (blocks[i] == my_block) ++max_value;
+                }
+
+                for (unsigned i = 0; i < number_of_blocks; ++i) {
+                    PartitionID cur_block = blocks[i];
+                    unsigned cur_value = 0;
+                    for (unsigned l = 0; l < number_of_blocks; ++l) {
+                        if (blocks[l] == cur_block) ++cur_value;
+                    }
+
+                    NodeWeight added = (edge_partition[e] != cur_block) + (edge_partition[reverse] != cur_block);
+                    if (cur_value > max_value && block_weights[cur_block] + added <= upper_bound) {
+                        max_value = cur_value;
+                        max_block = cur_block;
+                    }
+                }
+
+                if (max_block != my_block) {
+                    --block_weights[edge_partition[e]];
+                    --block_weights[edge_partition[reverse]];
+                    block_weights[max_block] += 2;
+                    edge_partition[e] = max_block;
+                    edge_partition[reverse] = max_block;
+                    ++change_counter;
+                }
+            }
+        }
+
+        if (change_counter == 0) break;
+    }
+}
+
+void spac::fix_cut_dominant_edges(std::vector<PartitionID> &edge_partition, PartitionID k) {
+    EdgeID number_of_bad_edges = 0;
+
+    // check if there are bad edges, i.e. dominant edges with endpoints in different blocks
+    for (NodeID u = 0; u < edge_partition.size(); ++u) {
+        NodeID v = m_view.dominant_neighbor(u);
+        if (edge_partition[u] != edge_partition[v]) {
+            ++number_of_bad_edges;
+        }
+    }
+
+    // if there are bad edges, fix them
+    if (number_of_bad_edges > 0) {
+        std::vector<NodeID> partition_sizes(k);
+        for (NodeID u = 0; u < edge_partition.size(); ++u) {
+            ++partition_sizes[edge_partition[u]];
+        }
+
+        for (NodeID u = 0; u < edge_partition.size(); ++u) {
+            NodeID v = m_view.dominant_neighbor(u);
+
+            PartitionID u_part = edge_partition[u];
+            PartitionID v_part = edge_partition[v];
+
+            // move one endpoint to the smaller partition
+            if (u_part != v_part) {
+                if (partition_sizes[u_part] < partition_sizes[v_part]) {
+                    ++partition_sizes[u_part];
+                    --partition_sizes[v_part];
+                    edge_partition[v] = u_part;
+                } else {
+                    --partition_sizes[u_part];
+                    ++partition_sizes[v_part];
+                    edge_partition[u] = v_part;
+                }
+            }
+        }
+
+    }
+}
+
+unsigned spac::calculate_vertex_cut(const std::vector<PartitionID> &edge_partition, PartitionID k) {
     unsigned cost = 0;
 
     for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
         if (m_input_graph.getNodeDegree(u) == 0) continue;
-        std::vector<bool> counted(m_split_graph.get_partition_count());
+        std::vector<bool> counted(k);
 
         for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
             PartitionID part = edge_partition[e];
@@ -170,43 +294,3 @@ unsigned spac::calculate_vertex_cut(const std::vector<PartitionID> &edge_partiti
 
     return cost;
 }
-
-void spac::find_reverse_edges() {
-    // reverse edges were already calculated, thus nothing to do
-    if (!m_reverse_edge.empty()) {
-        return;
-    }
-
-    const EdgeID guard = std::numeric_limits<EdgeID>::max();
-    m_reverse_edge.resize(m_input_graph.number_of_edges(), guard);
-
-    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
-        for (EdgeID e_uv = m_input_graph.get_first_edge(u); e_uv < m_input_graph.get_first_invalid_edge(u); ++e_uv) {
-            NodeID v = m_input_graph.getEdgeTarget(e_uv);
-
-            if (u < v) {
-                assert(m_reverse_edge[e_uv] == guard);
-            } else {
-                assert(m_reverse_edge[e_uv] != guard);
-                continue;
-            }
-
-#ifndef NDEBUG
-            bool found_reverse_edge = false;
-#endif
-            for (EdgeID e_vu = m_input_graph.get_first_edge(v); e_vu < m_input_graph.get_first_invalid_edge(v); ++e_vu) {
-                if (m_input_graph.getEdgeTarget(e_vu) == u) {
-                    m_reverse_edge[e_uv] = e_vu;
-                    m_reverse_edge[e_vu] = e_uv;
-#ifndef NDEBUG
-                    found_reverse_edge = true;
-#endif
-                    break;
-                }
-            }
-
-            assert(found_reverse_edge);
-            assert(m_reverse_edge[e_uv] != guard);
-        }
-    }
-}
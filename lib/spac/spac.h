@@ -12,6 +12,7 @@
 
 #include "data_structure/graph_access.h"
 #include "definitions.h"
+#include "split_graph_view.h"
 
 class spac {
 public:
@@ -19,19 +20,51 @@ public:
 
     graph_access &construct_split_graph();
 
-    void fix_cut_dominant_edges();
+    // contracts a size-constrained label propagation clustering of the split graph, computed on the view.
+    // both split vertices of an input edge are moved together, i.e. dominant edges are never cut.
+    // this is the first coarsening level, the split graph itself is never materialized
+    graph_access &construct_coarse_split_graph(NodeWeight cluster_upper_bound, unsigned iterations);
 
+    // partition of the split graph or of the coarse split graph, one block per edge of the input graph
     std::vector<PartitionID> project_partition();
 
-    unsigned calculate_vertex_cut(const std::vector<PartitionID> &edge_partition);
+    // label propagation on the view that moves both split vertices of an input edge at once,
+    // block weights stay below upper_bound
+    void refine_edge_partition(std::vector<PartitionID> &edge_partition, PartitionID k, NodeWeight upper_bound, unsigned iterations);
+
+    void fix_cut_dominant_edges(std::vector<PartitionID> &edge_partition, PartitionID k);
+
+    unsigned calculate_vertex_cut(const std::vector<PartitionID> &edge_partition, PartitionID k);
+
+    const split_graph_view &view() const { return m_view; }
 
 private:
-    void find_reverse_edges();
+    // labels of the auxiliary neighbors of both split vertices of the input edge e = (u,v), at most four
+    template <typename label_type>
+    unsigned auxiliary_labels(const std::vector<label_type> &labels, NodeID u, EdgeID e, label_type *out) const;
 
     graph_access &m_input_graph;
     graph_access m_split_graph;
-    EdgeWeight m_infinity;
-    std::vector<EdgeID> m_reverse_edge;
+    split_graph_view m_view;
+
+    // cluster of every split vertex and the contracted graph, used instead of m_split_graph
+    std::vector<NodeID> m_coarse_mapping;
+    graph_access m_coarse_split_graph;
 };
 
+template <typename label_type>
+unsigned spac::auxiliary_labels(const std::vector<label_type> &labels, NodeID u, EdgeID e, label_type *out) const {
+    EdgeID reverse = m_view.dominant_neighbor(e);
+    NodeID v = m_input_graph.getEdgeTarget(e);
+
+    unsigned count = 0;
+    for (unsigned i = 1; i < m_view.degree(u); ++i) {
+        out[count++] = labels[m_view.target(u, e, i)];
+    }
+    for (unsigned i = 1; i < m_view.degree(v); ++i) {
+        out[count++] = labels[m_view.target(v, reverse, i)];
+    }
+    return count;
+}
+
 #endif // KAHIP_SPAC_H
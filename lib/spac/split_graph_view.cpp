@@ -0,0 +1,101 @@
+/******************************************************************************
+ * split_graph_view.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "split_graph_view.h"
+
+split_graph_view::split_graph_view(graph_access &input_graph, EdgeWeight infinity)
+        : m_input_graph(input_graph), m_infinity(infinity), m_number_of_edges(0) {
+    find_reverse_edges();
+
+    for (NodeID u = 0; u < m_input_graph.number_of_nodes(); ++u) {
+        NodeID deg = m_input_graph.getNodeDegree(u);
+        if (deg > 0) {
+            m_number_of_edges += (EdgeID) deg * degree(u);
+        }
+    }
+}
+
+NodeID split_graph_view::source(NodeID split_node) const {
+    NodeID lo = 0;
+    NodeID hi = m_input_graph.number_of_nodes() - 1;
+    while (lo < hi) {
+        NodeID mid = lo + (hi - lo + 1) / 2;
+        if (m_input_graph.get_first_edge(mid) <= split_node) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return lo;
+}
+
+void split_graph_view::find_reverse_edges() {
+    // the edges (u,v) with u < v are bucketed by v in increasing order of u, the entries of v with
+    // targets smaller than v are sorted by target, both sequences then list the same edges in the same order.
+    // this needs O(m log d) time instead of scanning the adjacency of v for every edge
+    NodeID n = m_input_graph.number_of_nodes();
+    EdgeID m = m_input_graph.number_of_edges();
+    const EdgeID guard = std::numeric_limits<EdgeID>::max();
+    m_reverse_edge.assign(m, guard);
+
+    std::vector<EdgeID> bucket_start(n + 1, 0);
+    for (NodeID u = 0; u < n; ++u) {
+        for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+            NodeID v = m_input_graph.getEdgeTarget(e);
+            if (u < v) {
+                ++bucket_start[v + 1];
+            }
+        }
+    }
+    for (NodeID v = 0; v < n; ++v) {
+        bucket_start[v + 1] += bucket_start[v];
+    }
+
+    std::vector<EdgeID> bucket(bucket_start[n]);
+    std::vector<EdgeID> position(bucket_start.begin(), bucket_start.end() - 1);
+    for (NodeID u = 0; u < n; ++u) {
+        for (EdgeID e = m_input_graph.get_first_edge(u); e < m_input_graph.get_first_invalid_edge(u); ++e) {
+            NodeID v = m_input_graph.getEdgeTarget(e);
+            if (u < v) {
+                bucket[position[v]++] = e;
+            }
+        }
+    }
+
+    std::vector<std::pair<NodeID, EdgeID> > backward;
+    for (NodeID v = 0; v < n; ++v) {
+        backward.clear();
+        for (EdgeID e = m_input_graph.get_first_edge(v); e < m_input_graph.get_first_invalid_edge(v); ++e) {
+            NodeID u = m_input_graph.getEdgeTarget(e);
+            if (u < v) {
+                backward.push_back(std::make_pair(u, e));
+            }
+        }
+        std::sort(backward.begin(), backward.end());
+
+        assert(backward.size() == bucket_start[v + 1] - bucket_start[v]);
+        for (unsigned i = 0; i < backward.size(); ++i) {
+            EdgeID e_uv = bucket[bucket_start[v] + i];
+            EdgeID e_vu = backward[i].second;
+            assert(m_input_graph.getEdgeTarget(e_uv) == v);
+
+            m_reverse_edge[e_uv] = e_vu;
+            m_reverse_edge[e_vu] = e_uv;
+        }
+    }
+
+#ifndef NDEBUG
+    for (EdgeID e = 0; e < m; ++e) {
+        assert(m_reverse_edge[e] != guard);
+        assert(m_reverse_edge[m_reverse_edge[e]] == e);
+    }
+#endif
+}
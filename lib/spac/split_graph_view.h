@@ -0,0 +1,67 @@
+/******************************************************************************
+ * split_graph_view.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef KAHIP_SPLIT_GRAPH_VIEW_H
+#define KAHIP_SPLIT_GRAPH_VIEW_H
+
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "definitions.h"
+
+// implicit split graph of an input graph: split vertex e belongs to the CSR edge e = (u,v) of the input.
+// its neighbors are computed on the fly from the input CSR, i.e. the reverse split vertex (dominant edge,
+// weight infinity) and the previous / next edge of u in the cycle around u (auxiliary edges, weight 1).
+// the only additional memory is the reverse edge index
+class split_graph_view {
+public:
+    split_graph_view(graph_access &input_graph, EdgeWeight infinity);
+
+    NodeID number_of_nodes() const { return m_reverse_edge.size(); }
+    EdgeID number_of_edges() const { return m_number_of_edges; }
+
+    // number of neighbors of the split vertices of input node u.
+    // neighbor 0 is the dominant neighbor, the auxiliary neighbors follow
+    inline unsigned degree(NodeID u) const;
+    inline NodeID target(NodeID u, NodeID split_node, unsigned i) const;
+    inline EdgeWeight weight(unsigned i) const { return i == 0 ? m_infinity : 1; }
+
+    inline NodeID dominant_neighbor(NodeID split_node) const { return m_reverse_edge[split_node]; }
+
+    // input node the split vertex belongs to (binary search over the CSR)
+    NodeID source(NodeID split_node) const;
+
+private:
+    void find_reverse_edges();
+
+    graph_access &m_input_graph;
+    EdgeWeight m_infinity;
+    EdgeID m_number_of_edges;
+    std::vector<EdgeID> m_reverse_edge;
+};
+
+inline unsigned split_graph_view::degree(NodeID u) const {
+    NodeID deg = m_input_graph.getNodeDegree(u);
+    if (deg == 1) return 1;
+    if (deg == 2) return 2;
+    return 3;
+}
+
+inline NodeID split_graph_view::target(NodeID u, NodeID split_node, unsigned i) const {
+    if (i == 0) {
+        return m_reverse_edge[split_node];
+    }
+
+    EdgeID first = m_input_graph.get_first_edge(u);
+    EdgeID last = m_input_graph.get_first_invalid_edge(u) - 1;
+    if (i == 1) { // previous edge of u
+        return split_node == first ? last : split_node - 1;
+    }
+    return split_node == last ? first : split_node + 1; // next edge of u
+}
+
+#endif // KAHIP_SPLIT_GRAPH_VIEW_H
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * streaming_edge_partitioner.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include "streaming_edge_partitioner.h"
+
+streaming_edge_partitioner::streaming_edge_partitioner(PartitionID k, double imbalance, double lambda)
+        : m_k(k), m_imbalance(imbalance), m_lambda(lambda), m_read_nw(false), m_read_ew(false),
+          m_number_of_edges(0), m_capacity(0), m_max_load(0), m_words_per_node((k + 63) / 64) {
+}
+
+void streaming_edge_partitioner::set_vertex_prior(const std::vector<PartitionID> &prior) {
+    m_prior = prior;
+}
+
+int streaming_edge_partitioner::open_stream(const std::string &filename, std::ifstream &in, NodeID &n, EdgeID &m) {
+    in.open(filename.c_str());
+    if (!in) {
+        std::cerr << "Error opening " << filename << std::endl;
+        return 1;
+    }
+
+    std::string line;
+    std::getline(in, line);
+    while (line[0] == '%') {
+        std::getline(in, line);
+    }
+
+    long nmbNodes = 0;
+    long nmbEdges = 0;
+    int ew = 0;
+    std::stringstream ss(line);
+    ss >> nmbNodes;
+    ss >> nmbEdges;
+    ss >> ew;
+
+    if (2 * nmbEdges > std::numeric_limits<int>::max() || nmbNodes > std::numeric_limits<int>::max()) {
+        std::cerr << "The graph is too large. Currently only 32bit supported!" << std::endl;
+        return 1;
+    }
+
+    m_read_ew = ew == 1 || ew == 11;
+    m_read_nw = ew == 10 || ew == 11;
+    n = nmbNodes;
+    m = 2 * nmbEdges;
+    return 0;
+}
+
+int streaming_edge_partitioner::count_degrees(const std::string &filename) {
+    std::ifstream in;
+    NodeID n;
+    EdgeID m;
+    if (open_stream(filename, in, n, m)) {
+        return 1;
+    }
+
+    m_degree.assign(n, 0);
+    m_pending_start.assign(n + 1, 0);
+    NodeID node = 0;
+    std::string line;
+    while (std::getline(in, line) && node < n) {
+        if (line[0] == '%') {
+            continue;
+        }
+
+        std::stringstream ss(line);
+        NodeWeight weight;
+        if (m_read_nw) {
+            ss >> weight;
+        }
+
+        NodeID target;
+        EdgeWeight edge_weight;
+        while (ss >> target) {
+            if (m_read_ew) {
+                ss >> edge_weight;
+            }
+            ++m_degree[node];
+            if (target - 1 < node) {
+                ++m_pending_start[node + 1];
+            }
+        }
+        ++node;
+    }
+
+    for (NodeID v = 0; v < n; ++v) {
+        m_pending_start[v + 1] += m_pending_start[v];
+    }
+
+    EdgeID edges = 0;
+    for (NodeID v = 0; v < n; ++v) {
+        edges += m_degree[v];
+    }
+    if (edges != m) {
+        std::cerr << "number of edges in the file (" << edges << ") does not match the header (" << m << ")" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+int streaming_edge_partitioner::partition(const std::string &filename, const std::string &output_filename) {
+    // first pass: degrees
+    if (count_degrees(filename)) {
+        return 1;
+    }
+
+    NodeID n = m_degree.size();
+    if (!m_prior.empty() && m_prior.size() != n) {
+        std::cerr << "vertex prior has " << m_prior.size() << " entries, the graph has " << n << " nodes" << std::endl;
+        return 1;
+    }
+
+    // second pass: assignment
+    std::ifstream in;
+    EdgeID m;
+    if (open_stream(filename, in, n, m)) {
+        return 1;
+    }
+
+    // loads count undirected edges
+    EdgeID undirected_edges = m / 2;
+    m_capacity = std::max<EdgeID>(1, std::ceil((1 + m_imbalance) * std::ceil(undirected_edges / (double) m_k)));
+    m_max_load = 0;
+    m_block_load.assign(m_k, 0);
+    m_replicas.assign((uint64_t) n * m_words_per_node, 0);
+    m_pending_end.assign(m_pending_start.begin(), m_pending_start.end() - 1);
+    m_pending_source.resize(m_pending_start[n]);
+    m_pending_block.resize(m_pending_start[n]);
+    EdgeID unmatched = 0;
+    EdgeID matched = 0;
+
+    std::ofstream out(output_filename.c_str());
+    if (!out) {
+        std::cerr << "Error opening " << output_filename << std::endl;
+        return 1;
+    }
+
+    NodeID node = 0;
+    EdgeID e = 0;
+    std::string line;
+    while (std::getline(in, line) && node < n) {
+        if (line[0] == '%') {
+            continue;
+        }
+
+        std::stringstream ss(line);
+        NodeWeight weight;
+        if (m_read_nw) {
+            ss >> weight;
+        }
+
+        NodeID target;
+        EdgeWeight edge_weight;
+        while (ss >> target) {
+            if (m_read_ew) {
+                ss >> edge_weight;
+            }
+            --target;
+
+            if (target < node) {
+                // sources of the slots of node are sorted since the rows are read in order
+                std::vector<NodeID>::iterator begin = m_pending_source.begin() + m_pending_start[node];
+                std::vector<NodeID>::iterator end   = m_pending_source.begin() + m_pending_end[node];
+                std::vector<NodeID>::iterator it    = std::lower_bound(begin, end, target);
+                if (it != end && *it == target) {
+                    out << m_pending_block[it - m_pending_source.begin()] << "\n";
+                    ++e;
+                    ++matched;
+                    continue;
+                }
+                ++unmatched;
+            }
+
+            PartitionID block = assign_edge(node, target);
+            out << block << "\n";
+            ++e;
+            if (target > node) {
+                if (m_pending_end[target] < m_pending_start[target + 1]) {
+                    m_pending_source[m_pending_end[target]] = node;
+                    m_pending_block[m_pending_end[target]++] = block;
+                } else {
+                    ++unmatched;
+                }
+            }
+        }
+        ++node;
+    }
+    out.close();
+    m_number_of_edges = e;
+
+    // decisions that no reverse entry picked up
+    for (NodeID v = 0; v < n; ++v) {
+        unmatched += m_pending_end[v] - m_pending_start[v];
+    }
+    unmatched -= matched;
+
+    if (unmatched > 0) {
+        std::cerr << unmatched << " edges have no reverse edge in the graph file" << std::endl;
+    }
+
+    std::vector<EdgeID>().swap(m_pending_start);
+    std::vector<EdgeID>().swap(m_pending_end);
+    std::vector<NodeID>().swap(m_pending_source);
+    std::vector<PartitionID>().swap(m_pending_block);
+
+    return 0;
+}
+
+PartitionID streaming_edge_partitioner::assign_edge(NodeID u, NodeID v) {
+    EdgeID min_load = *std::min_element(m_block_load.begin(), m_block_load.end());
+
+    double degree_sum = (double) m_degree[u] + m_degree[v];
+    double theta_u = m_degree[u] / degree_sum;
+    double theta_v = m_degree[v] / degree_sum;
+
+    PartitionID best_block = 0;
+    double best_score = -std::numeric_limits<double>::max();
+    for (PartitionID block = 0; block < m_k; ++block) {
+        if (m_block_load[block] >= m_capacity) {
+            continue;
+        }
+
+        // replicating the endpoint with the lower degree is more expensive
+        double score = 0;
+        if (has_replica(u, block)) score += 2 - theta_u;
+        if (has_replica(v, block)) score += 2 - theta_v;
+        if (!m_prior.empty()) {
+            if (m_prior[u] == block) score += 1 - theta_u;
+            if (m_prior[v] == block) score += 1 - theta_v;
+        }
+        score += m_lambda * (m_max_load - m_block_load[block]) / (1.0 + m_max_load - min_load);
+
+        if (score > best_score) {
+            best_score = score;
+            best_block = block;
+        }
+    }
+
+    add_replica(u, best_block);
+    add_replica(v, best_block);
+    m_max_load = std::max(m_max_load, ++m_block_load[best_block]);
+
+    return best_block;
+}
+
+unsigned streaming_edge_partitioner::vertex_cut() const {
+    unsigned cost = 0;
+    for (NodeID v = 0; v < m_degree.size(); ++v) {
+        if (m_degree[v] == 0) continue;
+
+        unsigned replicas = 0;
+        for (unsigned w = 0; w < m_words_per_node; ++w) {
+            replicas += __builtin_popcountll(m_replicas[(uint64_t) v * m_words_per_node + w]);
+        }
+        cost += replicas - 1;
+    }
+    return cost;
+}
+
+double streaming_edge_partitioner::edge_balance() const {
+    EdgeID edges = 0;
+    for (PartitionID block = 0; block < m_k; ++block) {
+        edges += m_block_load[block];
+    }
+    // both directions of an edge are counted, as in quality_metrics::edge_balance
+    return 2 * m_max_load / std::ceil(2 * edges / (double) m_k);
+}
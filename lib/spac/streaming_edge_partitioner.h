@@ -0,0 +1,83 @@
+/******************************************************************************
+ * streaming_edge_partitioner.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef KAHIP_STREAMING_EDGE_PARTITIONER_H
+#define KAHIP_STREAMING_EDGE_PARTITIONER_H
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "definitions.h"
+
+// edge partitioning without the split graph: the METIS file is streamed twice.
+// the first pass only counts degrees, the second pass assigns every edge with the HDRF score
+// (replication of the endpoints weighted by their degree plus a balance term), optionally
+// biased towards a (coarse) vertex partition that is given as a prior.
+// the blocks are written to the output file as soon as they are decided. memory is n * k bits
+// of replica sets, O(n) counters and one buffer slot (source and block) per undirected edge
+// for the decision that the reverse entry picks up. the buffer is sized in the first pass and
+// never grows, but it is not bounded: it holds m/2 slots, i.e. memory is still linear in m.
+// the result has the format of spac::project_partition, i.e. one block per edge in CSR order
+// and both directions of an edge are in the same block
+class streaming_edge_partitioner {
+public:
+    streaming_edge_partitioner(PartitionID k, double imbalance, double lambda);
+
+    // prior[v] is the block preferred for the edges of v, has to be set before partition
+    void set_vertex_prior(const std::vector<PartitionID> &prior);
+
+    // writes the block of every edge to output_filename, one line per edge
+    int partition(const std::string &filename, const std::string &output_filename);
+
+    // same value as spac::calculate_vertex_cut and quality_metrics::edge_balance for the result
+    unsigned vertex_cut() const;
+    double edge_balance() const;
+
+    NodeID number_of_nodes() const { return m_degree.size(); }
+    EdgeID number_of_edges() const { return m_number_of_edges; }
+
+private:
+    int open_stream(const std::string &filename, std::ifstream &in, NodeID &n, EdgeID &m);
+    int count_degrees(const std::string &filename);
+    PartitionID assign_edge(NodeID u, NodeID v);
+
+    inline bool has_replica(NodeID v, PartitionID block) const {
+        return (m_replicas[(uint64_t) v * m_words_per_node + block / 64] >> (block % 64)) & 1;
+    }
+
+    inline void add_replica(NodeID v, PartitionID block) {
+        m_replicas[(uint64_t) v * m_words_per_node + block / 64] |= (uint64_t) 1 << (block % 64);
+    }
+
+    PartitionID m_k;
+    double m_imbalance;
+    double m_lambda;
+    bool m_read_nw;
+    bool m_read_ew;
+
+    EdgeID m_number_of_edges;
+    EdgeID m_capacity;
+    EdgeID m_max_load;
+    unsigned m_words_per_node;
+
+    std::vector<NodeID> m_degree;
+    std::vector<EdgeID> m_block_load;
+    std::vector<uint64_t> m_replicas;
+    std::vector<PartitionID> m_prior;
+
+    // decisions for edges (u,v), u < v, until the entry of v is read.
+    // the slots of v are m_pending_start[v], ..., m_pending_start[v+1]-1, one for each entry u < v
+    // in the row of v; they are filled up to m_pending_end[v] in increasing order of u
+    std::vector<EdgeID> m_pending_start;
+    std::vector<EdgeID> m_pending_end;
+    std::vector<NodeID> m_pending_source;
+    std::vector<PartitionID> m_pending_block;
+};
+
+#endif // KAHIP_STREAMING_EDGE_PARTITIONER_H
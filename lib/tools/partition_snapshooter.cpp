@@ -11,7 +11,7 @@
 #include "graph_io.h"
 #include "partition_snapshooter.h"
 
-partition_snapshooter* partition_snapshooter::m_instance = NULL;
+thread_local partition_snapshooter* partition_snapshooter::m_instance = NULL;
 
 partition_snapshooter::partition_snapshooter() {
         m_buffer_size = 500;
@@ -10,7 +10,7 @@
 
 #include "data_structure/graph_access.h"
 
-//buffered partition snapshooter (singleton)
+//buffered partition snapshooter (singleton per thread)
 class partition_snapshooter {
         public: 
                 static partition_snapshooter * getInstance();
@@ -26,7 +26,7 @@ class partition_snapshooter {
                 partition_snapshooter(const partition_snapshooter&) {}          
 
                 virtual ~partition_snapshooter();
-                static partition_snapshooter* m_instance;
+                static thread_local partition_snapshooter* m_instance;
 
                 unsigned int m_buffer_size;
                 unsigned int m_idx;
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * phase_timer.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#include "phase_timer.h"
+
+thread_local phase_timer* phase_timer::m_instance = NULL;
+
+phase_timer::phase_timer() {
+        m_enabled = false;
+        m_current = 0;
+}
+
+phase_timer * phase_timer::getInstance() {
+        if( m_instance == NULL ) {
+                m_instance = new phase_timer();
+        }
+        return m_instance;
+}
+
+void phase_timer::enable(const std::string & name) {
+        m_phases.clear();
+        m_phases.resize(1);
+
+        phase & root          = m_phases[0];
+        root.name             = name;
+        root.parent           = 0;
+        root.calls            = 1;
+        root.time             = 0;
+        root.start            = timestamp();
+        root.start_peak_rss   = peak_rss();
+        root.peak_rss         = 0;
+        root.peak_rss_growth  = 0;
+
+        m_current = 0;
+        m_enabled = true;
+}
+
+void phase_timer::begin(const std::string & name) {
+        if( !m_enabled ) return;
+
+        unsigned idx = m_phases.size();
+        std::vector< unsigned > & children = m_phases[m_current].children;
+        for( unsigned i = 0; i < children.size(); i++) {
+                if( m_phases[children[i]].name == name ) {
+                        idx = children[i];
+                        break;
+                }
+        }
+
+        if( idx == m_phases.size() ) {
+                phase p;
+                p.name            = name;
+                p.parent          = m_current;
+                p.calls           = 0;
+                p.time            = 0;
+                p.peak_rss        = 0;
+                p.peak_rss_growth = 0;
+                m_phases.push_back(p);
+                m_phases[m_current].children.push_back(idx);
+        }
+
+        phase & p         = m_phases[idx];
+        p.start           = timestamp();
+        p.start_peak_rss  = peak_rss();
+        m_current         = idx;
+}
+
+void phase_timer::end() {
+        if( !m_enabled || m_current == 0 ) return;
+
+        phase & p         = m_phases[m_current];
+        long cur_peak_rss = peak_rss();
+        p.time           += timestamp() - p.start;
+        p.calls++;
+        p.peak_rss        = std::max(p.peak_rss, cur_peak_rss);
+        p.peak_rss_growth = std::max(p.peak_rss_growth, cur_peak_rss - p.start_peak_rss);
+
+        m_current = p.parent;
+}
+
+double & phase_timer::value(const std::string & key) {
+        std::vector< std::pair< std::string, double > > & values = m_phases[m_current].values;
+        for( unsigned i = 0; i < values.size(); i++) {
+                if( values[i].first == key ) return values[i].second;
+        }
+        values.push_back(std::make_pair(key, 0.0));
+        return values.back().second;
+}
+
+void phase_timer::set_value(const std::string & key, double new_value) {
+        if( !m_enabled ) return;
+        value(key) = new_value;
+}
+
+void phase_timer::add_value(const std::string & key, double new_value) {
+        if( !m_enabled ) return;
+        value(key) += new_value;
+}
+
+void phase_timer::max_value(const std::string & key, double new_value) {
+        if( !m_enabled ) return;
+        double & cur_value = value(key);
+        cur_value = std::max(cur_value, new_value);
+}
+
+void phase_timer::write_json(std::ostream & out) {
+        if( m_phases.empty() ) return;
+
+        phase & root          = m_phases[0];
+        long cur_peak_rss     = peak_rss();
+        root.time             = timestamp() - root.start;
+        root.peak_rss         = cur_peak_rss;
+        root.peak_rss_growth  = cur_peak_rss - root.start_peak_rss;
+
+        write_phase(out, 0, 0);
+        out << std::endl;
+}
+
+bool phase_timer::write_json(const std::string & filename) {
+        std::ofstream f(filename.c_str());
+        if( !f ) return false;
+
+        write_json(f);
+        return true;
+}
+
+void phase_timer::write_phase(std::ostream & out, unsigned idx, unsigned indent) {
+        const phase & p = m_phases[idx];
+        std::string pad(indent, ' ');
+
+        std::string name;
+        for( unsigned i = 0; i < p.name.size(); i++) {
+                if( p.name[i] == '"' || p.name[i] == '\\' ) name += '\\';
+                name += p.name[i];
+        }
+
+        out << pad << "{" << std::endl;
+        out << pad << "  \"name\": \"" << name << "\"," << std::endl;
+        out << pad << "  \"time\": " << std::setprecision(9) << p.time << "," << std::endl;
+        out << pad << "  \"calls\": " << p.calls << "," << std::endl;
+        out << pad << "  \"peak_rss_kb\": " << p.peak_rss << "," << std::endl;
+        out << pad << "  \"peak_rss_growth_kb\": " << p.peak_rss_growth << "," << std::endl;
+
+        out << pad << "  \"values\": {";
+        for( unsigned i = 0; i < p.values.size(); i++) {
+                out << (i == 0 ? "" : ", ") << "\"" << p.values[i].first << "\": " << std::setprecision(15) << p.values[i].second;
+        }
+        out << "}," << std::endl;
+
+        out << pad << "  \"children\": [";
+        for( unsigned i = 0; i < p.children.size(); i++) {
+                out << (i == 0 ? "" : ",") << std::endl;
+                write_phase(out, p.children[i], indent + 4);
+        }
+        if( !p.children.empty() ) out << std::endl << pad << "  ";
+        out << "]" << std::endl;
+        out << pad << "}";
+}
+
+double phase_timer::timestamp() {
+        struct timeval tp;
+        gettimeofday(&tp, NULL);
+        return double(tp.tv_sec) + tp.tv_usec / 1000000.;
+}
+
+long phase_timer::peak_rss() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss; // kilobytes on linux
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * phase_timer.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PHASE_TIMER_Q7XK2M4D
+#define PHASE_TIMER_Q7XK2M4D
+
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// hierarchical timing of the phases of the partitioner (singleton per thread).
+// a phase is opened with begin and closed with end, phases opened while another one is open become
+// its children. opening a phase again under the same parent accumulates time and calls.
+// for every phase the wall time, the number of calls, the peak resident set size at its end and
+// the largest growth of the peak during one call are recorded, together with values set by the
+// code (e.g. the size of a level or the improvement of a refinement algorithm).
+// the timer is disabled by default, begin / end / values then return immediately
+class phase_timer {
+        public:
+                static phase_timer * getInstance();
+
+                // starts a new report, name is the name of the root phase
+                void enable(const std::string & name);
+                bool enabled() const { return m_enabled; }
+
+                void begin(const std::string & name);
+                void end();
+
+                // values of the innermost open phase
+                void set_value(const std::string & key, double value);
+                void add_value(const std::string & key, double value);
+                void max_value(const std::string & key, double value); // keeps the largest value
+
+                // writes the phase tree as json, the root phase ends when the report is written
+                void write_json(std::ostream & out);
+                bool write_json(const std::string & filename);
+
+        private:
+                struct phase {
+                        std::string name;
+                        unsigned    parent;
+                        unsigned    calls;
+                        double      time;
+                        double      start;
+                        long        start_peak_rss;
+                        long        peak_rss;
+                        long        peak_rss_growth;
+
+                        std::vector< unsigned > children;
+                        std::vector< std::pair< std::string, double > > values;
+                };
+
+                phase_timer();
+                phase_timer(const phase_timer&) {}
+
+                double & value(const std::string & key);
+                void write_phase(std::ostream & out, unsigned idx, unsigned indent);
+
+                static double timestamp();
+                static long peak_rss();
+
+                static thread_local phase_timer* m_instance;
+
+                bool     m_enabled;
+                unsigned m_current;
+
+                std::vector< phase > m_phases;
+};
+
+// opens a phase for the lifetime of the object
+class phase_scope {
+        public:
+                phase_scope(const std::string & name) {
+                        phase_timer::getInstance()->begin(name);
+                }
+
+                ~phase_scope() {
+                        phase_timer::getInstance()->end();
+                }
+};
+
+
+#endif /* end of include guard: PHASE_TIMER_Q7XK2M4D */
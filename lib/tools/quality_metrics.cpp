@@ -7,6 +7,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <omp.h>
 
 #include "quality_metrics.h"
 #include "data_structure/union_find.h"
@@ -110,97 +112,116 @@ EdgeWeight quality_metrics::edge_cut_connected(graph_access & G, int * partition
 }
 
 
-EdgeWeight quality_metrics::max_communication_volume(graph_access & G, int * partition_map) {
+std::vector<EdgeWeight> quality_metrics::block_communication_volume(graph_access & G, int * partition_map) {
     std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-    forall_nodes(G, node) {
-        PartitionID block = partition_map[node];
-        std::vector<bool> block_incident(G.get_partition_count(), false);
-        block_incident[block] = true;
 
+    // last_seen[b] == node iff block b is incident to node, i.e. no per node reset is needed
+    std::vector<NodeID> last_seen(G.get_partition_count(), std::numeric_limits<NodeID>::max());
+    forall_nodes(G, node) {
+        PartitionID block = partition_map == NULL ? G.getPartitionIndex(node) : partition_map[node];
+        last_seen[block] = node;
         int num_incident_blocks = 0;
 
         forall_out_edges(G, e, node) {
             NodeID target = G.getEdgeTarget(e);
-            PartitionID target_block = partition_map[target];
-            if(!block_incident[target_block]) {
-                block_incident[target_block] = true;
+            PartitionID target_block = partition_map == NULL ? G.getPartitionIndex(target) : partition_map[target];
+            if(last_seen[target_block] != node) {
+                last_seen[target_block] = node;
                 num_incident_blocks++;
             }
         } endfor
         block_volume[block] += num_incident_blocks;
     } endfor
 
-    EdgeWeight max_comm_volume = *(std::max_element(block_volume.begin(), block_volume.end()));
-    return max_comm_volume;
+    return block_volume;
 }
 
-EdgeWeight quality_metrics::min_communication_volume(graph_access & G) {
-    std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-    forall_nodes(G, node) {
-        PartitionID block = G.getPartitionIndex(node);
-        std::vector<bool> block_incident(G.get_partition_count(), false);
-        block_incident[block] = true;
-        int num_incident_blocks = 0;
-
-        forall_out_edges(G, e, node) {
-            NodeID target = G.getEdgeTarget(e);
-            PartitionID target_block = G.getPartitionIndex(target);
-            if(!block_incident[target_block]) {
-                block_incident[target_block] = true;
-                num_incident_blocks++;
-            }
-        } endfor
-        block_volume[block] += num_incident_blocks;
-    } endfor
+EdgeWeight quality_metrics::max_communication_volume(graph_access & G, int * partition_map) {
+    std::vector<EdgeWeight> block_volume = block_communication_volume(G, partition_map);
+    return *(std::max_element(block_volume.begin(), block_volume.end()));
+}
 
-    EdgeWeight min_comm_volume = *(std::min_element(block_volume.begin(), block_volume.end()));
-    return min_comm_volume;
+EdgeWeight quality_metrics::min_communication_volume(graph_access & G) {
+    std::vector<EdgeWeight> block_volume = block_communication_volume(G, NULL);
+    return *(std::min_element(block_volume.begin(), block_volume.end()));
 }
 
 EdgeWeight quality_metrics::max_communication_volume(graph_access & G) {
-    std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-    forall_nodes(G, node) {
-        PartitionID block = G.getPartitionIndex(node);
-        std::vector<bool> block_incident(G.get_partition_count(), false);
-        block_incident[block] = true;
-        int num_incident_blocks = 0;
-
-        forall_out_edges(G, e, node) {
-            NodeID target = G.getEdgeTarget(e);
-            PartitionID target_block = G.getPartitionIndex(target);
-            if(!block_incident[target_block]) {
-                block_incident[target_block] = true;
-                num_incident_blocks++;
-            }
-        } endfor
-        block_volume[block] += num_incident_blocks;
-    } endfor
-
-    EdgeWeight max_comm_volume = *(std::max_element(block_volume.begin(), block_volume.end()));
-    return max_comm_volume;
+    std::vector<EdgeWeight> block_volume = block_communication_volume(G, NULL);
+    return *(std::max_element(block_volume.begin(), block_volume.end()));
 }
 
 EdgeWeight quality_metrics::total_communication_volume(graph_access & G) {
-    std::vector<EdgeWeight> block_volume(G.get_partition_count(),0);
-    forall_nodes(G, node) {
-        PartitionID block = G.getPartitionIndex(node);
-        std::vector<bool> block_incident(G.get_partition_count(), false);
-        block_incident[block] = true;
-        int num_incident_blocks = 0;
+    std::vector<EdgeWeight> block_volume = block_communication_volume(G, NULL);
+    return std::accumulate(block_volume.begin(), block_volume.end(),0);
+}
 
-        forall_out_edges(G, e, node) {
-            NodeID target = G.getEdgeTarget(e);
-            PartitionID target_block = G.getPartitionIndex(target);
-            if(!block_incident[target_block]) {
-                block_incident[target_block] = true;
-                num_incident_blocks++;
-            }
-        } endfor
-        block_volume[block] += num_incident_blocks;
-    } endfor
+partition_metrics quality_metrics::all_metrics(graph_access & G, int num_threads) {
+        PartitionID k = G.get_partition_count();
+
+        long long edge_cut       = 0;
+        long long boundary_nodes = 0;
+        std::vector<long long>  block_weight(k, 0);
+        std::vector<long long>  block_degree(k, 0);
+        std::vector<EdgeWeight> block_volume(k, 0);
+
+        #pragma omp parallel num_threads(std::max(1, num_threads))
+        {
+                long long local_cut      = 0;
+                long long local_boundary = 0;
+                std::vector<long long>  local_weight(k, 0);
+                std::vector<long long>  local_degree(k, 0);
+                std::vector<EdgeWeight> local_volume(k, 0);
+                std::vector<NodeID>     last_seen(k, std::numeric_limits<NodeID>::max());
+
+                #pragma omp for schedule(dynamic, 4096)
+                for( long i = 0; i < (long)G.number_of_nodes(); i++) {
+                        NodeID node       = i;
+                        PartitionID block = G.getPartitionIndex(node);
+                        local_weight[block] += G.getNodeWeight(node);
+                        local_degree[block] += G.getNodeDegree(node);
+                        last_seen[block]     = node;
+
+                        int num_incident_blocks = 0;
+                        forall_out_edges(G, e, node) {
+                                PartitionID target_block = G.getPartitionIndex(G.getEdgeTarget(e));
+                                if( target_block == block ) continue;
+
+                                local_cut += G.getEdgeWeight(e);
+                                if(last_seen[target_block] != node) {
+                                        last_seen[target_block] = node;
+                                        num_incident_blocks++;
+                                }
+                        } endfor
+
+                        if( num_incident_blocks > 0 ) local_boundary++;
+                        local_volume[block] += num_incident_blocks;
+                }
+
+                #pragma omp critical
+                {
+                        edge_cut       += local_cut;
+                        boundary_nodes += local_boundary;
+                        for( PartitionID b = 0; b < k; b++) {
+                                block_weight[b] += local_weight[b];
+                                block_degree[b] += local_degree[b];
+                                block_volume[b] += local_volume[b];
+                        }
+                }
+        }
 
-    EdgeWeight total_comm_volume = std::accumulate(block_volume.begin(), block_volume.end(),0);
-    return total_comm_volume;
+        double total_weight = std::accumulate(block_weight.begin(), block_weight.end(), 0.0);
+        double total_degree = std::accumulate(block_degree.begin(), block_degree.end(), 0.0);
+
+        partition_metrics metrics;
+        metrics.edge_cut                   = edge_cut / 2;
+        metrics.boundary_nodes             = boundary_nodes;
+        metrics.balance                    = *std::max_element(block_weight.begin(), block_weight.end()) / ceil(total_weight / (double)k);
+        metrics.balance_edges              = *std::max_element(block_degree.begin(), block_degree.end()) / ceil(total_degree / (double)k);
+        metrics.max_communication_volume   = *std::max_element(block_volume.begin(), block_volume.end());
+        metrics.min_communication_volume   = *std::min_element(block_volume.begin(), block_volume.end());
+        metrics.total_communication_volume = std::accumulate(block_volume.begin(), block_volume.end(), 0);
+        return metrics;
 }
 
 
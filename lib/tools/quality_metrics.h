@@ -13,6 +13,17 @@
 #include "data_structure/matrix/matrix.h"
 #include "partition_config.h"
 
+// the metrics reported by the evaluator
+struct partition_metrics {
+        EdgeWeight edge_cut;
+        int        boundary_nodes;
+        double     balance;
+        double     balance_edges;
+        EdgeWeight max_communication_volume;
+        EdgeWeight min_communication_volume;
+        EdgeWeight total_communication_volume;
+};
+
 class quality_metrics {
 public:
         quality_metrics();
@@ -34,8 +45,16 @@ public:
         double balance_separator(graph_access & G);
         double edge_balance(graph_access &G, const std::vector<PartitionID> &edge_partition);
 
+        // computes all of partition_metrics in a single pass over the graph using num_threads threads,
+        // the values are the same as the ones of the individual functions
+        partition_metrics all_metrics(graph_access & G, int num_threads = 1);
+
         NodeWeight total_qap(graph_access & C, matrix & D, std::vector< NodeID > & rank_assign);
         NodeWeight total_qap(matrix & C, matrix & D, std::vector< NodeID > & rank_assign);
+
+private:
+        // number of blocks adjacent to the nodes of a block (other than the block), summed per block
+        std::vector<EdgeWeight> block_communication_volume(graph_access & G, int * partition_map);
 };
 
 #endif /* end of include guard: QUALITY_METRICS_10HC2I5M */
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * radix_sort.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef RADIX_SORT_R8D2K5WQ
+#define RADIX_SORT_R8D2K5WQ
+
+#include <algorithm>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+class radix_sort {
+public:
+        // maps a double to an unsigned key with the same order
+        static inline uint64_t ordered_key( double value ) {
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                return (bits >> 63) ? ~bits : bits | (1ULL << 63);
+        }
+
+        // sorts values by keys in increasing order (both are permuted), the sort is stable.
+        // LSD radix sort with 8 bit digits, passes in which all keys share the digit are skipped.
+        // with num_threads > 1 the input is split into one chunk per thread, every pass counts per chunk
+        // and scatters the chunks in parallel, the result does not depend on the number of threads
+        template < typename T >
+        static void sort( std::vector< uint64_t > & keys, std::vector< T > & values, int num_threads = 1 ) {
+                const uint64_t n = keys.size();
+                int chunks       = std::max(1, std::min(num_threads, (int)(n / MIN_CHUNK_SIZE)));
+
+                std::vector< uint64_t > tmp_keys(n);
+                std::vector< T >        tmp_values(n);
+                std::vector< uint64_t > offsets(chunks * BUCKETS);
+
+                for( unsigned shift = 0; shift < 64; shift += DIGIT_BITS) {
+                        std::fill(offsets.begin(), offsets.end(), 0);
+
+                        #pragma omp parallel for num_threads(chunks) schedule(static, 1)
+                        for( int c = 0; c < chunks; c++) {
+                                uint64_t * count = &offsets[c * BUCKETS];
+                                for( uint64_t i = chunk_begin(n, chunks, c); i < chunk_begin(n, chunks, c+1); i++) {
+                                        count[(keys[i] >> shift) & (BUCKETS-1)]++;
+                                }
+                        }
+
+                        // bucket major, chunk minor prefix sums keep the sort stable
+                        uint64_t sum     = 0;
+                        bool     trivial = false;
+                        for( unsigned b = 0; b < BUCKETS; b++) {
+                                uint64_t bucket_size = 0;
+                                for( int c = 0; c < chunks; c++) {
+                                        uint64_t count          = offsets[c * BUCKETS + b];
+                                        offsets[c * BUCKETS + b] = sum;
+                                        sum                    += count;
+                                        bucket_size            += count;
+                                }
+                                if( bucket_size == n ) trivial = true;
+                        }
+                        if( trivial ) continue;
+
+                        #pragma omp parallel for num_threads(chunks) schedule(static, 1)
+                        for( int c = 0; c < chunks; c++) {
+                                uint64_t * offset = &offsets[c * BUCKETS];
+                                for( uint64_t i = chunk_begin(n, chunks, c); i < chunk_begin(n, chunks, c+1); i++) {
+                                        uint64_t pos    = offset[(keys[i] >> shift) & (BUCKETS-1)]++;
+                                        tmp_keys[pos]   = keys[i];
+                                        tmp_values[pos] = values[i];
+                                }
+                        }
+
+                        keys.swap(tmp_keys);
+                        values.swap(tmp_values);
+                }
+        }
+
+private:
+        static const unsigned DIGIT_BITS     = 8;
+        static const unsigned BUCKETS        = 1 << DIGIT_BITS;
+        static const uint64_t MIN_CHUNK_SIZE = 1 << 14;
+
+        static inline uint64_t chunk_begin( uint64_t n, int chunks, int c ) {
+                return n * c / chunks;
+        }
+};
+
+
+#endif /* end of include guard: RADIX_SORT_R8D2K5WQ */
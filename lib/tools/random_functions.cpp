@@ -7,8 +7,8 @@
 
 #include "random_functions.h"
 
-MersenneTwister random_functions::m_mt;
-int random_functions::m_seed = 0;
+thread_local MersenneTwister random_functions::m_mt;
+thread_local int random_functions::m_seed = 0;
 
 random_functions::random_functions()  {
 }
@@ -9,6 +9,7 @@
 #define RANDOM_FUNCTIONS_RMEPKWYT
 
 #include <iostream>
+#include <omp.h>
 #include <random>
 #include <vector>
 
@@ -162,7 +163,14 @@ class random_functions {
                 }
 
                 static double nextDouble(double lb, double rb) {
-                        double rnbr   = (double) rand() / (double) RAND_MAX; // rnd in 0,1
+                        // the sequential sequence is kept, rand() is shared by all threads though
+                        double rnbr;
+                        if( !omp_in_parallel() ) {
+                                rnbr = (double) rand() / (double) RAND_MAX; // rnd in 0,1
+                        } else {
+                                std::uniform_real_distribution<double> A(0.0, 1.0);
+                                rnbr = A(m_mt);
+                        }
                         double length = rb - lb;
                         rnbr         *= length;
                         rnbr         += lb;
@@ -172,13 +180,14 @@ class random_functions {
 
                 static void setSeed(int seed) {
                         m_seed = seed;
-                        srand(seed);
+                        if( !omp_in_parallel() ) srand(seed);
                         m_mt.seed(m_seed);
                 }
 
         private:
-                static int m_seed;
-                static MersenneTwister m_mt;
+                // every thread owns its generator, threads have to be seeded using setSeed
+                static thread_local int m_seed;
+                static thread_local MersenneTwister m_mt;
 };
 
 #endif /* end of include guard: RANDOM_FUNCTIONS_RMEPKWYT */
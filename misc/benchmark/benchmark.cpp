@@ -0,0 +1,494 @@
+/******************************************************************************
+ * benchmark.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <argtable3.h>
+#include <cmath>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "graph_generators.h"
+#include "graph_io.h"
+#include "partition/partition_config.h"
+#include "partition/uncoarsening/refinement/quotient_graph_refinement/complete_boundary.h"
+#include "quality_metrics.h"
+#include "timer.h"
+
+// benchmark driver: generates the synthetic graph classes at a fixed scale, runs the kahip binaries on
+// them with fixed seeds and records the wall time, the peak memory (maximum resident set size of the
+// child process), the objective and the balance of every run in a csv file. the objective is computed
+// from the output file of the run: the edge cut for kaffpa, the separator weight for node_separator,
+// the vertex cut for edge_partitioning and the quadratic assignment objective for process mapping.
+// with a baseline (the csv file of an earlier run) the ratios of time, memory and objective are reported
+// per run type and the program fails if one of them got worse by more than the tolerance
+
+enum run_kind {
+        RUN_PARTITION,
+        RUN_SEPARATOR,
+        RUN_EDGE_PARTITION,
+        RUN_MAPPING
+};
+
+struct benchmark_run {
+        std::string name;
+        std::string binary;
+        std::vector< std::string > args;
+        run_kind kind;
+        PartitionID k;
+};
+
+struct benchmark_result {
+        std::string graph;
+        NodeID nodes;
+        EdgeID edges;
+        std::string run;
+        int seed;
+        double time;
+        long memory;
+        double objective;
+        double balance;
+        bool ok;
+};
+
+// process mapping onto 3 x 4 x 4 PEs. 48 is not a power of two, for powers of two kaffpa
+// skips the mapping algorithm and keeps the identity
+static const char* MAPPING_HIERARCHY = "3:4:4";
+static const char* MAPPING_DISTANCES = "1:10:100";
+
+static std::vector< std::string > split(const std::string & str, char delim) {
+        std::vector< std::string > parts;
+        std::istringstream f(str);
+        std::string s;
+        while( getline(f, s, delim) ) {
+                parts.push_back(s);
+        }
+        return parts;
+}
+
+static std::vector< benchmark_run > all_runs(const std::string & bin_dir, PartitionID k) {
+        std::vector< benchmark_run > runs;
+        std::string kstr = "--k=" + std::to_string(k);
+
+        const char* presets[] = {"fast", "eco", "strong"};
+        for( unsigned i = 0; i < 3; i++) {
+                benchmark_run run;
+                run.name   = std::string("kaffpa_") + presets[i];
+                run.binary = bin_dir + "/kaffpa";
+                run.args   = {kstr, std::string("--preconfiguration=") + presets[i]};
+                run.kind   = RUN_PARTITION;
+                run.k      = k;
+                runs.push_back(run);
+        }
+
+        benchmark_run separator;
+        separator.name   = "node_separator";
+        separator.binary = bin_dir + "/node_separator";
+        separator.args   = {"--preconfiguration=eco"};
+        separator.kind   = RUN_SEPARATOR;
+        separator.k      = 2;
+        runs.push_back(separator);
+
+        benchmark_run edge_partition;
+        edge_partition.name   = "edge_partitioning";
+        edge_partition.binary = bin_dir + "/edge_partitioning";
+        edge_partition.args   = {kstr, "--preconfiguration=eco"};
+        edge_partition.kind   = RUN_EDGE_PARTITION;
+        edge_partition.k      = k;
+        runs.push_back(edge_partition);
+
+        benchmark_run streaming = edge_partition;
+        streaming.name = "edge_partitioning_streaming";
+        streaming.args.push_back("--streaming");
+        runs.push_back(streaming);
+
+        benchmark_run mapping;
+        mapping.name   = "mapping";
+        mapping.binary = bin_dir + "/kaffpa";
+        mapping.args   = {"--k=48", "--preconfiguration=eco", "--enable_mapping",
+                          std::string("--hierarchy_parameter_string=") + MAPPING_HIERARCHY,
+                          std::string("--distance_parameter_string=") + MAPPING_DISTANCES};
+        mapping.kind   = RUN_MAPPING;
+        mapping.k      = 48;
+        runs.push_back(mapping);
+
+        return runs;
+}
+
+// runs the binary with stdout / stderr redirected to the log file, returns false if it failed
+static bool execute(const std::string & binary, const std::vector< std::string > & args, const std::string & log,
+                    double & time, long & memory) {
+        timer t;
+        pid_t pid = fork();
+        if( pid < 0 ) return false;
+
+        if( pid == 0 ) {
+                int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if( fd >= 0 ) {
+                        dup2(fd, STDOUT_FILENO);
+                        dup2(fd, STDERR_FILENO);
+                        close(fd);
+                }
+
+                std::vector< char* > argv;
+                argv.push_back(const_cast< char* >(binary.c_str()));
+                for( unsigned i = 0; i < args.size(); i++) {
+                        argv.push_back(const_cast< char* >(args[i].c_str()));
+                }
+                argv.push_back(NULL);
+                execv(binary.c_str(), argv.data());
+                _exit(127);
+        }
+
+        int status = 0;
+        struct rusage usage;
+        wait4(pid, &status, 0, &usage);
+        time   = t.elapsed();
+        memory = usage.ru_maxrss; // kilobytes on linux
+
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// objective and balance of the output file of a run
+static bool evaluate(const benchmark_run & run, graph_access & G, const std::string & output,
+                     double & objective, double & balance) {
+        quality_metrics qm;
+        std::ifstream in(output.c_str());
+        if( !in ) return false;
+        in.close();
+
+        if( run.kind == RUN_EDGE_PARTITION ) {
+                // readVector fills a vector of the right size
+                std::vector< PartitionID > edge_partition(G.number_of_edges(), run.k);
+                graph_io::readVector(edge_partition, output);
+
+                // vertex cut: every node is replicated in each block of its edges
+                G.set_partition_count(run.k);
+                std::vector< NodeID > last_seen(run.k, std::numeric_limits< NodeID >::max());
+                long vertex_cut = 0;
+                forall_nodes(G, node) {
+                        long replicas = 0;
+                        forall_out_edges(G, e, node) {
+                                PartitionID block = edge_partition[e];
+                                if( block >= run.k ) return false;
+                                if( last_seen[block] != node ) {
+                                        last_seen[block] = node;
+                                        replicas++;
+                                }
+                        } endfor
+                        if( replicas > 0 ) vertex_cut += replicas - 1;
+                } endfor
+
+                objective = vertex_cut;
+                balance   = qm.edge_balance(G, edge_partition);
+                return true;
+        }
+
+        if( graph_io::readPartition(G, output) ) return false;
+
+        if( run.kind == RUN_SEPARATOR ) {
+                G.set_partition_count(3);
+                G.setSeparatorBlock(2);
+                NodeWeight separator_weight = 0;
+                forall_nodes(G, node) {
+                        if( G.getPartitionIndex(node) == 2 ) separator_weight += G.getNodeWeight(node);
+                } endfor
+
+                objective = separator_weight;
+                balance   = qm.balance_separator(G);
+                return true;
+        }
+
+        G.set_partition_count(run.k);
+        balance = qm.balance(G);
+        if( run.kind == RUN_PARTITION ) {
+                objective = qm.edge_cut(G);
+                return true;
+        }
+
+        // the blocks of the output are already the PEs
+        PartitionConfig config;
+        std::vector< std::string > group_sizes = split(MAPPING_HIERARCHY, ':');
+        std::vector< std::string > distances   = split(MAPPING_DISTANCES, ':');
+        for( unsigned i = 0; i < group_sizes.size(); i++) {
+                config.group_sizes.push_back(stoi(group_sizes[i]));
+                config.distances.push_back(stoi(distances[i]));
+        }
+
+        graph_access C;
+        complete_boundary boundary(&G);
+        boundary.build();
+        boundary.getUnderlyingQuotientGraph(C);
+
+        online_distance_matrix D(run.k, run.k);
+        D.setPartitionConfig(config);
+        std::vector< NodeID > identity(run.k);
+        for( PartitionID block = 0; block < run.k; block++) {
+                identity[block] = block;
+        }
+        objective = qm.total_qap(C, D, identity);
+        return true;
+}
+
+static void write_csv(const std::vector< benchmark_result > & results, const std::string & filename) {
+        std::ofstream f(filename.c_str());
+        f << "graph,nodes,edges,run,seed,time,memory_kb,objective,balance,status" << std::endl;
+        for( unsigned i = 0; i < results.size(); i++) {
+                const benchmark_result & r = results[i];
+                f << r.graph << "," << r.nodes << "," << r.edges << "," << r.run << "," << r.seed << ","
+                  << std::setprecision(6) << r.time << "," << r.memory << ","
+                  << std::setprecision(12) << r.objective << "," << std::setprecision(6) << r.balance << ","
+                  << (r.ok ? "ok" : "failed") << std::endl;
+        }
+}
+
+static bool read_csv(const std::string & filename, std::vector< benchmark_result > & results) {
+        std::ifstream f(filename.c_str());
+        if( !f ) return false;
+
+        std::string line;
+        std::getline(f, line); // header
+        while( std::getline(f, line) ) {
+                std::vector< std::string > fields = split(line, ',');
+                if( fields.size() != 10 ) continue;
+
+                benchmark_result r;
+                r.graph     = fields[0];
+                r.nodes     = std::stoul(fields[1]);
+                r.edges     = std::stoul(fields[2]);
+                r.run       = fields[3];
+                r.seed      = std::stoi(fields[4]);
+                r.time      = std::stod(fields[5]);
+                r.memory    = std::stol(fields[6]);
+                r.objective = std::stod(fields[7]);
+                r.balance   = std::stod(fields[8]);
+                r.ok        = fields[9] == "ok";
+                results.push_back(r);
+        }
+        return true;
+}
+
+// prints the geometric means of the ratios current / baseline per run type, returns the number of regressions
+static int compare(const std::vector< benchmark_result > & results, const std::vector< benchmark_result > & baseline,
+                   double tolerance) {
+        std::map< std::string, const benchmark_result* > baseline_of;
+        for( unsigned i = 0; i < baseline.size(); i++) {
+                const benchmark_result & b = baseline[i];
+                baseline_of[b.graph + "," + b.run + "," + std::to_string(b.seed)] = &b;
+        }
+
+        struct ratios {
+                unsigned matched;
+                unsigned worse_objective;
+                double log_time;
+                double log_memory;
+                double log_objective;
+        };
+        std::vector< std::string > order;
+        std::map< std::string, ratios > per_run;
+
+        int regressions = 0;
+        for( unsigned i = 0; i < results.size(); i++) {
+                const benchmark_result & r = results[i];
+                std::string key = r.graph + "," + r.run + "," + std::to_string(r.seed);
+                if( baseline_of.find(key) == baseline_of.end() ) continue;
+
+                const benchmark_result & b = *baseline_of[key];
+                if( !b.ok ) continue;
+                if( !r.ok ) {
+                        std::cout <<  "regression: " << key << " failed"  << std::endl;
+                        regressions++;
+                        continue;
+                }
+
+                if( per_run.find(r.run) == per_run.end() ) {
+                        order.push_back(r.run);
+                        ratios empty = {0, 0, 0, 0, 0};
+                        per_run[r.run] = empty;
+                }
+
+                // +1 keeps objectives of 0 comparable
+                ratios & cur = per_run[r.run];
+                cur.matched++;
+                cur.log_time      += std::log(std::max(r.time, 1e-3) / std::max(b.time, 1e-3));
+                cur.log_memory    += std::log((r.memory + 1.0) / (b.memory + 1.0));
+                cur.log_objective += std::log((r.objective + 1.0) / (b.objective + 1.0));
+                if( r.objective > b.objective ) cur.worse_objective++;
+        }
+
+        std::cout <<  std::endl << "ratios current / baseline (geometric means)"  << std::endl;
+        std::cout <<  std::left << std::setw(30) << "run" << std::setw(10) << "runs" << std::setw(10) << "time"
+                  <<  std::setw(10) << "memory" << std::setw(12) << "objective" << "worse objective" << std::endl;
+
+        double limit = 1.0 + tolerance / 100.0;
+        for( unsigned i = 0; i < order.size(); i++) {
+                const ratios & cur = per_run[order[i]];
+                double time      = std::exp(cur.log_time / cur.matched);
+                double memory    = std::exp(cur.log_memory / cur.matched);
+                double objective = std::exp(cur.log_objective / cur.matched);
+
+                std::cout <<  std::left << std::setw(30) << order[i] << std::setw(10) << cur.matched
+                          <<  std::setw(10) << std::setprecision(3) << time
+                          <<  std::setw(10) << memory << std::setw(12) << objective << cur.worse_objective << std::endl;
+
+                if( time > limit )      { std::cout <<  "regression: time of " << order[i]  << std::endl;      regressions++; }
+                if( memory > limit )    { std::cout <<  "regression: memory of " << order[i]  << std::endl;    regressions++; }
+                if( objective > limit ) { std::cout <<  "regression: objective of " << order[i]  << std::endl; regressions++; }
+        }
+
+        return regressions;
+}
+
+int main(int argn, char **argv) {
+        const char *progname = argv[0];
+
+        struct arg_lit *help      = arg_lit0(NULL, "help", "Print help.");
+        struct arg_str *bin_dir   = arg_str0(NULL, "bin_dir", NULL, "Directory of the kahip binaries. Default: .");
+        struct arg_str *work_dir  = arg_str0(NULL, "work_dir", NULL, "Directory for the generated graphs and the outputs of the runs. Default: benchmark_graphs");
+        struct arg_int *scale     = arg_int0(NULL, "scale", NULL, "The graphs have roughly 2^scale nodes. Default: 16");
+        struct arg_int *seeds     = arg_int0(NULL, "seeds", NULL, "Every run is repeated with the seeds 0, ..., seeds-1. Default: 3");
+        struct arg_int *k         = arg_int0(NULL, "k", NULL, "Number of blocks (process mapping always uses 48 PEs). Default: 16");
+        struct arg_str *graphs    = arg_str0(NULL, "graphs", NULL, "Comma separated graph classes. Default: grid2d,grid3d,rgg2d,tri2d,rmat,ba");
+        struct arg_str *runs      = arg_str0(NULL, "runs", NULL, "Comma separated runs. Default: kaffpa_fast,kaffpa_eco,kaffpa_strong,node_separator,edge_partitioning,edge_partitioning_streaming,mapping");
+        struct arg_str *output    = arg_str0(NULL, "output_filename", NULL, "CSV file with the results. Default: benchmark.csv");
+        struct arg_str *baseline  = arg_str0(NULL, "baseline", NULL, "CSV file of an earlier benchmark to compare with.");
+        struct arg_dbl *tolerance = arg_dbl0(NULL, "tolerance", NULL, "Largest accepted increase of the geometric mean of time, memory and objective compared to the baseline in %. Default: 10");
+        struct arg_end *end       = arg_end(100);
+
+        void* argtable[] = { help, bin_dir, work_dir, scale, seeds, k, graphs, runs, output, baseline, tolerance, end };
+
+        int nerrors = arg_parse(argn, argv, argtable);
+        if( help->count > 0 ) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 0;
+        }
+
+        if( nerrors > 0 ) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        std::string bin        = bin_dir->count   > 0 ? bin_dir->sval[0]  : ".";
+        std::string dir        = work_dir->count  > 0 ? work_dir->sval[0] : "benchmark_graphs";
+        unsigned graph_scale   = scale->count     > 0 ? scale->ival[0]    : 16;
+        int number_of_seeds    = seeds->count     > 0 ? seeds->ival[0]    : 3;
+        PartitionID blocks     = k->count         > 0 ? k->ival[0]        : 16;
+        std::string csv        = output->count    > 0 ? output->sval[0]   : "benchmark.csv";
+        double max_increase    = tolerance->count > 0 ? tolerance->dval[0] : 10;
+        std::vector< std::string > graph_classes = split(graphs->count > 0 ? graphs->sval[0] : "grid2d,grid3d,rgg2d,tri2d,rmat,ba", ',');
+
+        std::vector< benchmark_run > selected_runs = all_runs(bin, blocks);
+        if( runs->count > 0 ) {
+                std::vector< std::string > names = split(runs->sval[0], ',');
+                std::vector< benchmark_run > filtered;
+                for( unsigned i = 0; i < names.size(); i++) {
+                        bool found = false;
+                        for( unsigned j = 0; j < selected_runs.size(); j++) {
+                                if( selected_runs[j].name == names[i] ) {
+                                        filtered.push_back(selected_runs[j]);
+                                        found = true;
+                                }
+                        }
+                        if( !found ) {
+                                std::cerr <<  "unknown run " << names[i]  << std::endl;
+                                return 1;
+                        }
+                }
+                selected_runs = filtered;
+        }
+
+        mkdir(dir.c_str(), 0755);
+
+        std::vector< benchmark_result > results;
+        for( unsigned g = 0; g < graph_classes.size(); g++) {
+                std::string graph_name = graph_classes[g] + "_s" + std::to_string(graph_scale);
+                std::string graph_file = dir + "/" + graph_name + ".graph";
+
+                // the graphs are generated with seed 0, i.e. the same graph in every benchmark
+                graph_access G;
+                std::ifstream exists(graph_file.c_str());
+                if( exists ) {
+                        exists.close();
+                        graph_io::readGraphWeighted(G, graph_file);
+                } else {
+                        if( !graph_generators::generate(G, graph_classes[g], graph_scale, 0) ) {
+                                std::cerr <<  "unknown graph class " << graph_classes[g]  << std::endl;
+                                return 1;
+                        }
+                        graph_io::writeGraph(G, graph_file);
+                }
+                std::cout <<  graph_name << " has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges()/2 <<  " edges"  << std::endl;
+
+                for( unsigned r = 0; r < selected_runs.size(); r++) {
+                        const benchmark_run & run = selected_runs[r];
+                        for( int seed = 0; seed < number_of_seeds; seed++) {
+                                std::string partition_file = dir + "/" + run.name + ".partition";
+                                std::string log_file       = dir + "/" + run.name + ".log";
+                                unlink(partition_file.c_str());
+
+                                std::vector< std::string > args;
+                                args.push_back(graph_file);
+                                args.insert(args.end(), run.args.begin(), run.args.end());
+                                args.push_back("--seed=" + std::to_string(seed));
+                                args.push_back("--output_filename=" + partition_file);
+
+                                benchmark_result result;
+                                result.graph     = graph_name;
+                                result.nodes     = G.number_of_nodes();
+                                result.edges     = G.number_of_edges()/2;
+                                result.run       = run.name;
+                                result.seed      = seed;
+                                result.objective = 0;
+                                result.balance   = 0;
+                                result.ok        = execute(run.binary, args, log_file, result.time, result.memory)
+                                                && evaluate(run, G, partition_file, result.objective, result.balance);
+                                results.push_back(result);
+
+                                std::cout <<  "  " << std::left << std::setw(30) << run.name << " seed " << seed;
+                                if( result.ok ) {
+                                        std::cout <<  " time " << result.time << " memory " << result.memory << "kb"
+                                                  <<  " objective " << result.objective << " balance " << result.balance << std::endl;
+                                } else {
+                                        std::cout <<  " failed, see " << log_file  << std::endl;
+                                }
+                        }
+                }
+        }
+
+        write_csv(results, csv);
+        std::cout <<  "results written to " << csv  << std::endl;
+
+        int regressions = 0;
+        if( baseline->count > 0 ) {
+                std::vector< benchmark_result > baseline_results;
+                if( !read_csv(baseline->sval[0], baseline_results) ) {
+                        std::cerr <<  "Error opening " << baseline->sval[0]  << std::endl;
+                        return 1;
+                }
+                regressions = compare(results, baseline_results, max_increase);
+                std::cout <<  regressions << " regressions"  << std::endl;
+        }
+
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * graph_generator.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <argtable3.h>
+#include <regex.h>
+#include <iostream>
+#include <string>
+
+#include "graph_generators.h"
+#include "graph_io.h"
+
+// writes a synthetic graph of the benchmark suite in metis format
+int main(int argn, char **argv) {
+        const char *progname = argv[0];
+
+        struct arg_lit *help        = arg_lit0(NULL, "help", "Print help.");
+        struct arg_rex *graph_class = arg_rex1(NULL, "class", "^(grid2d|grid3d|rgg2d|tri2d|rmat|ba)$", "CLASS", REG_EXTENDED, "Graph class. One of {grid2d, grid3d, rgg2d, tri2d, rmat, ba}.");
+        struct arg_int *scale       = arg_int1(NULL, "scale", NULL, "The graph has roughly 2^scale nodes.");
+        struct arg_int *seed        = arg_int0(NULL, "seed", NULL, "Seed of the generator. Default: 0");
+        struct arg_str *output      = arg_str1(NULL, "output_filename", NULL, "Name of the graph file to write.");
+        struct arg_end *end         = arg_end(100);
+
+        void* argtable[] = { help, graph_class, scale, seed, output, end };
+
+        int nerrors = arg_parse(argn, argv, argtable);
+        if( help->count > 0 ) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 0;
+        }
+
+        if( nerrors > 0 ) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        graph_access G;
+        graph_generators::generate(G, graph_class->sval[0], scale->ival[0], seed->count > 0 ? seed->ival[0] : 0);
+        std::cout <<  "graph has " <<  G.number_of_nodes() <<  " nodes and " <<  G.number_of_edges() <<  " edges"  << std::endl;
+
+        int ret = graph_io::writeGraph(G, output->sval[0]);
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return ret;
+}
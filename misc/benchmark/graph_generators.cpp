@@ -0,0 +1,241 @@
+/******************************************************************************
+ * graph_generators.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "graph_generators.h"
+
+// uniform double in (0,1)
+static inline double next_double(std::mt19937 & rng) {
+        return (rng() + 0.5) / 4294967296.0;
+}
+
+void graph_generators::grid2d(graph_access & G, NodeID nx, NodeID ny) {
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        for( NodeID y = 0; y < ny; y++) {
+                for( NodeID x = 0; x < nx; x++) {
+                        NodeID node = y*nx + x;
+                        if( x + 1 < nx ) edges.push_back(std::make_pair(node, node + 1));
+                        if( y + 1 < ny ) edges.push_back(std::make_pair(node, node + nx));
+                }
+        }
+        build(G, nx*ny, edges);
+}
+
+void graph_generators::grid3d(graph_access & G, NodeID nx, NodeID ny, NodeID nz) {
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        for( NodeID z = 0; z < nz; z++) {
+                for( NodeID y = 0; y < ny; y++) {
+                        for( NodeID x = 0; x < nx; x++) {
+                                NodeID node = (z*ny + y)*nx + x;
+                                if( x + 1 < nx ) edges.push_back(std::make_pair(node, node + 1));
+                                if( y + 1 < ny ) edges.push_back(std::make_pair(node, node + nx));
+                                if( z + 1 < nz ) edges.push_back(std::make_pair(node, node + nx*ny));
+                        }
+                }
+        }
+        build(G, nx*ny*nz, edges);
+}
+
+void graph_generators::rgg2d(graph_access & G, NodeID n, double radius, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector< double > x(n), y(n);
+        for( NodeID node = 0; node < n; node++) {
+                x[node] = next_double(rng);
+                y[node] = next_double(rng);
+        }
+
+        // points are bucketed into cells of side length >= radius, only neighboring cells have to be compared
+        NodeID cells_per_side = std::max(1, (int)std::floor(1.0 / radius));
+        std::vector< NodeID > cell(n);
+        std::vector< NodeID > cell_start(cells_per_side*cells_per_side + 1, 0);
+        for( NodeID node = 0; node < n; node++) {
+                NodeID cx  = std::min(cells_per_side - 1, (NodeID)(x[node]*cells_per_side));
+                NodeID cy  = std::min(cells_per_side - 1, (NodeID)(y[node]*cells_per_side));
+                cell[node] = cy*cells_per_side + cx;
+                cell_start[cell[node] + 1]++;
+        }
+        for( unsigned c = 0; c + 1 < cell_start.size(); c++) {
+                cell_start[c + 1] += cell_start[c];
+        }
+        std::vector< NodeID > bucket(n);
+        std::vector< NodeID > pos(cell_start.begin(), cell_start.end() - 1);
+        for( NodeID node = 0; node < n; node++) {
+                bucket[pos[cell[node]]++] = node;
+        }
+
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        double squared_radius = radius*radius;
+        for( NodeID node = 0; node < n; node++) {
+                int cx = cell[node] % cells_per_side;
+                int cy = cell[node] / cells_per_side;
+                for( int ny = std::max(0, cy - 1); ny <= std::min((int)cells_per_side - 1, cy + 1); ny++) {
+                        for( int nx = std::max(0, cx - 1); nx <= std::min((int)cells_per_side - 1, cx + 1); nx++) {
+                                NodeID c = ny*cells_per_side + nx;
+                                for( NodeID i = cell_start[c]; i < cell_start[c + 1]; i++) {
+                                        NodeID target = bucket[i];
+                                        if( target <= node ) continue;
+
+                                        double dx = x[node] - x[target];
+                                        double dy = y[node] - y[target];
+                                        if( dx*dx + dy*dy <= squared_radius ) {
+                                                edges.push_back(std::make_pair(node, target));
+                                        }
+                                }
+                        }
+                }
+        }
+        build(G, n, edges);
+}
+
+void graph_generators::triangulated_grid(graph_access & G, NodeID nx, NodeID ny, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        for( NodeID y = 0; y < ny; y++) {
+                for( NodeID x = 0; x < nx; x++) {
+                        NodeID node = y*nx + x;
+                        if( x + 1 < nx ) edges.push_back(std::make_pair(node, node + 1));
+                        if( y + 1 < ny ) edges.push_back(std::make_pair(node, node + nx));
+                        if( x + 1 < nx && y + 1 < ny ) {
+                                if( rng() & 1 ) {
+                                        edges.push_back(std::make_pair(node, node + nx + 1));
+                                } else {
+                                        edges.push_back(std::make_pair(node + 1, node + nx));
+                                }
+                        }
+                }
+        }
+        build(G, nx*ny, edges);
+}
+
+void graph_generators::rmat(graph_access & G, unsigned scale, unsigned edge_factor,
+                            double a, double b, double c, unsigned seed) {
+        std::mt19937 rng(seed);
+        NodeID n = (NodeID)1 << scale;
+
+        std::vector< std::pair< NodeID, NodeID > > edges;
+        edges.reserve((uint64_t)edge_factor * n);
+        for( uint64_t i = 0; i < (uint64_t)edge_factor * n; i++) {
+                NodeID source = 0;
+                NodeID target = 0;
+                for( unsigned level = 0; level < scale; level++) {
+                        double r = next_double(rng);
+                        if( r < a ) {
+                                continue;
+                        } else if( r < a + b ) {
+                                target |= (NodeID)1 << level;
+                        } else if( r < a + b + c ) {
+                                source |= (NodeID)1 << level;
+                        } else {
+                                source |= (NodeID)1 << level;
+                                target |= (NodeID)1 << level;
+                        }
+                }
+                edges.push_back(std::make_pair(source, target));
+        }
+        build(G, n, edges);
+}
+
+void graph_generators::barabasi_albert(graph_access & G, NodeID n, unsigned d, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::vector< std::pair< NodeID, NodeID > > edges;
+
+        // every edge adds both endpoints, drawing from this list is proportional to the degree
+        std::vector< NodeID > endpoints;
+        NodeID initial = std::min(n, (NodeID)d + 1);
+        for( NodeID u = 0; u < initial; u++) {
+                for( NodeID v = u + 1; v < initial; v++) {
+                        edges.push_back(std::make_pair(u, v));
+                        endpoints.push_back(u);
+                        endpoints.push_back(v);
+                }
+        }
+
+        for( NodeID node = initial; node < n; node++) {
+                uint64_t size = endpoints.size();
+                for( unsigned i = 0; i < d; i++) {
+                        uint64_t r    = ((uint64_t)rng() << 32) | rng();
+                        NodeID target = endpoints[r % size];
+                        edges.push_back(std::make_pair(node, target));
+                        endpoints.push_back(node);
+                        endpoints.push_back(target);
+                }
+        }
+        build(G, n, edges);
+}
+
+bool graph_generators::generate(graph_access & G, const std::string & graph_class, unsigned scale, unsigned seed) {
+        NodeID n     = (NodeID)1 << scale;
+        NodeID side  = (NodeID)1 << ((scale + 1) / 2);
+        NodeID other = (NodeID)1 << (scale / 2);
+
+        if( graph_class == "grid2d" ) {
+                grid2d(G, side, other);
+        } else if( graph_class == "grid3d" ) {
+                grid3d(G, (NodeID)1 << ((scale + 2) / 3), (NodeID)1 << ((scale + 1) / 3), (NodeID)1 << (scale / 3));
+        } else if( graph_class == "rgg2d" ) {
+                // radius of the rgg instances of the 10th DIMACS challenge
+                rgg2d(G, n, 0.55 * std::sqrt(std::log((double)n) / n), seed);
+        } else if( graph_class == "tri2d" ) {
+                triangulated_grid(G, side, other, seed);
+        } else if( graph_class == "rmat" ) {
+                // graph500 parameters
+                rmat(G, scale, 8, 0.57, 0.19, 0.19, seed);
+        } else if( graph_class == "ba" ) {
+                barabasi_albert(G, n, 4, seed);
+        } else {
+                return false;
+        }
+        return true;
+}
+
+void graph_generators::build(graph_access & G, NodeID n, std::vector< std::pair< NodeID, NodeID > > & edges) {
+        for( uint64_t i = 0; i < edges.size(); i++) {
+                if( edges[i].first > edges[i].second ) std::swap(edges[i].first, edges[i].second);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        std::vector< EdgeID > start(n + 1, 0);
+        for( uint64_t i = 0; i < edges.size(); i++) {
+                if( edges[i].first == edges[i].second ) continue;
+                start[edges[i].first + 1]++;
+                start[edges[i].second + 1]++;
+        }
+        for( NodeID node = 0; node < n; node++) {
+                start[node + 1] += start[node];
+        }
+
+        std::vector< NodeID > adjacency(start[n]);
+        std::vector< EdgeID > pos(start.begin(), start.end() - 1);
+        for( uint64_t i = 0; i < edges.size(); i++) {
+                NodeID u = edges[i].first;
+                NodeID v = edges[i].second;
+                if( u == v ) continue;
+                adjacency[pos[u]++] = v;
+        }
+        for( uint64_t i = 0; i < edges.size(); i++) {
+                NodeID u = edges[i].first;
+                NodeID v = edges[i].second;
+                if( u == v ) continue;
+                adjacency[pos[v]++] = u;
+        }
+
+        G.start_construction(n, start[n]);
+        for( NodeID node = 0; node < n; node++) {
+                NodeID shadow = G.new_node();
+                G.setNodeWeight(shadow, 1);
+                G.setPartitionIndex(shadow, 0);
+                for( EdgeID e = start[node]; e < start[node + 1]; e++) {
+                        EdgeID shadow_edge = G.new_edge(shadow, adjacency[e]);
+                        G.setEdgeWeight(shadow_edge, 1);
+                }
+        }
+        G.finish_construction();
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+ * graph_generators.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef GRAPH_GENERATORS_M3TQ8ZK1
+#define GRAPH_GENERATORS_M3TQ8ZK1
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "data_structure/graph_access.h"
+
+// synthetic graph classes for benchmarks. the graphs only depend on the parameters and the seed,
+// random numbers are drawn from std::mt19937 without the (implementation defined) distributions
+// so that the same graph is generated with every compiler / standard library.
+// self-loops and parallel edges are removed, all nodes and edges have weight 1
+class graph_generators {
+public:
+        // nx x ny grid, 4-neighborhood
+        static void grid2d(graph_access & G, NodeID nx, NodeID ny);
+
+        // nx x ny x nz grid, 6-neighborhood
+        static void grid3d(graph_access & G, NodeID nx, NodeID ny, NodeID nz);
+
+        // n random points in the unit square, connected if their distance is at most radius
+        static void rgg2d(graph_access & G, NodeID n, double radius, unsigned seed);
+
+        // nx x ny grid where every cell is split into two triangles along a random diagonal,
+        // a planar triangulation with average degree close to 6 (the structure of delaunay graphs)
+        static void triangulated_grid(graph_access & G, NodeID nx, NodeID ny, unsigned seed);
+
+        // recursive matrix (kronecker) graph with 2^scale nodes and edge_factor * 2^scale sampled edges
+        static void rmat(graph_access & G, unsigned scale, unsigned edge_factor,
+                         double a, double b, double c, unsigned seed);
+
+        // barabasi-albert preferential attachment, every new node is connected to d existing nodes
+        static void barabasi_albert(graph_access & G, NodeID n, unsigned d, unsigned seed);
+
+        // graph of the given class with roughly 2^scale nodes, returns false if the class is unknown.
+        // classes: grid2d, grid3d, rgg2d, tri2d, rmat, ba
+        static bool generate(graph_access & G, const std::string & graph_class, unsigned scale, unsigned seed);
+
+private:
+        // builds G from an undirected edge list, edges are normalized in place
+        static void build(graph_access & G, NodeID n, std::vector< std::pair< NodeID, NodeID > > & edges);
+};
+
+
+#endif /* end of include guard: GRAPH_GENERATORS_M3TQ8ZK1 */
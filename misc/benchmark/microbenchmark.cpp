@@ -0,0 +1,570 @@
+/******************************************************************************
+ * microbenchmark.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+#include <argtable3.h>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stack>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "algorithms/push_relabel.h"
+#include "coarsening/contraction.h"
+#include "coarsening/edge_rating/edge_ratings.h"
+#include "coarsening/matching/gpa/gpa_matching.h"
+#include "configuration.h"
+#include "data_structure/flow_graph.h"
+#include "data_structure/graph_access.h"
+#include "data_structure/matrix/online_distance_matrix.h"
+#include "data_structure/priority_queues/bucket_pq.h"
+#include "data_structure/priority_queues/maxNodeHeap.h"
+#include "graph_generators.h"
+#include "parhip_kernels.h"
+#include "random_functions.h"
+#include "timer.h"
+#include "uncoarsening/refinement/quotient_graph_refinement/complete_boundary.h"
+
+// a kernel of the partitioner that is timed on a synthetic input.
+// prepare builds the input once, setup restores the state a run changes,
+// only run is timed. run returns a checksum of its result so that the work
+// cannot be optimized away, equal inputs have to give equal checksums
+class micro_kernel {
+public:
+        virtual ~micro_kernel() {};
+
+        virtual std::string name() = 0;
+        virtual void prepare(unsigned scale, unsigned seed) = 0;
+        virtual void setup() {};
+        virtual uint64_t run() = 0;
+
+        // number of elementary operations of the last run (queue operations, edges, lookups)
+        virtual uint64_t operations() = 0;
+};
+
+static uint64_t mix(uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return x;
+}
+
+static void configure(PartitionConfig & config, unsigned seed) {
+        configuration cfg;
+        cfg.standard(config);
+        cfg.eco(config);
+        config.k    = 16;
+        config.seed = seed;
+        random_functions::setSeed(seed);
+}
+
+// operation mix of a local search: half of the nodes are inserted, then the maximum is moved
+// repeatedly and four random nodes get new gains (inserted if they are not in the queue and were not moved yet)
+class queue_kernel : public micro_kernel {
+public:
+        queue_kernel(bool bucket) : m_bucket(bucket), m_queue(NULL), m_operations(0) {};
+        ~queue_kernel() override { delete m_queue; };
+
+        std::string name() override { return m_bucket ? "bucket_pq" : "maxNodeHeap"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                m_nodes = 1 << scale;
+                std::mt19937 rng(seed);
+                for( NodeID node = 0; node < m_nodes; node++) {
+                        if( rng() & 1 ) m_initial.push_back(std::make_pair(node, random_gain(rng)));
+                }
+                for( NodeID i = 0; i < 4 * m_nodes; i++) {
+                        m_updates.push_back(std::make_pair(rng() % m_nodes, random_gain(rng)));
+                }
+        }
+
+        void setup() override {
+                delete m_queue;
+                if( m_bucket ) {
+                        m_queue = new bucket_pq(GAIN_SPAN);
+                } else {
+                        m_queue = new maxNodeHeap();
+                }
+                m_moved.assign(m_nodes, false);
+        }
+
+        uint64_t run() override {
+                uint64_t checksum = 0;
+                m_operations      = m_initial.size();
+                for( unsigned i = 0; i < m_initial.size(); i++) {
+                        m_queue->insert(m_initial[i].first, m_initial[i].second);
+                }
+
+                for( unsigned i = 0; i < m_updates.size() && !m_queue->empty(); i += 4) {
+                        checksum += m_queue->maxValue() + GAIN_SPAN;
+                        NodeID node = m_queue->deleteMax();
+                        m_moved[node] = true;
+                        m_operations++;
+
+                        for( unsigned j = i; j < i + 4; j++) {
+                                NodeID target = m_updates[j].first;
+                                if( m_moved[target] ) continue;
+                                if( m_queue->contains(target) ) {
+                                        m_queue->changeKey(target, m_updates[j].second);
+                                } else {
+                                        m_queue->insert(target, m_updates[j].second);
+                                }
+                                m_operations++;
+                        }
+                }
+                return checksum;
+        }
+
+        uint64_t operations() override { return m_operations; };
+
+private:
+        static const Gain GAIN_SPAN = 100;
+
+        static Gain random_gain(std::mt19937 & rng) {
+                return (Gain)(rng() % (2*GAIN_SPAN + 1)) - GAIN_SPAN;
+        }
+
+        bool m_bucket;
+        refinement_pq* m_queue;
+        NodeID m_nodes;
+        uint64_t m_operations;
+        std::vector< bool > m_moved;
+        std::vector< std::pair< NodeID, Gain > > m_initial;
+        std::vector< std::pair< NodeID, Gain > > m_updates;
+};
+
+// quotient graph and boundaries of a triangulated grid cut into 16 stripes
+class boundary_kernel : public micro_kernel {
+public:
+        boundary_kernel() : m_boundary(NULL) {};
+        ~boundary_kernel() override { delete m_boundary; };
+
+        std::string name() override { return "complete_boundary::build"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                graph_generators::generate(m_G, "tri2d", scale, seed);
+                PartitionID k       = 16;
+                NodeID stripe_size = (m_G.number_of_nodes() + k - 1) / k;
+                m_G.set_partition_count(k);
+                forall_nodes(m_G, node) {
+                        m_G.setPartitionIndex(node, node / stripe_size);
+                } endfor
+        }
+
+        void setup() override {
+                delete m_boundary;
+                m_boundary = NULL;
+        }
+
+        uint64_t run() override {
+                m_boundary = new complete_boundary(&m_G);
+                m_boundary->build();
+
+                uint64_t checksum = 0;
+                QuotientGraphEdges qgraph_edges;
+                m_boundary->getQuotientGraphEdges(qgraph_edges);
+                for( unsigned i = 0; i < qgraph_edges.size(); i++) {
+                        checksum += m_boundary->getEdgeCut(qgraph_edges[i].lhs, qgraph_edges[i].rhs);
+                }
+                return checksum;
+        }
+
+        uint64_t operations() override { return m_G.number_of_edges(); };
+
+private:
+        graph_access m_G;
+        complete_boundary* m_boundary;
+};
+
+// contraction of a gpa matching of a triangulated grid
+class contraction_kernel : public micro_kernel {
+public:
+        contraction_kernel() : m_coarser(NULL) {};
+        ~contraction_kernel() override { delete m_coarser; };
+
+        std::string name() override { return "contraction::contract"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                graph_generators::generate(m_G, "tri2d", scale, seed);
+                configure(m_config, seed);
+
+                edge_ratings rating(m_config);
+                rating.rate(m_G, 0);
+
+                gpa_matching matcher;
+                matcher.match(m_config, m_G, m_matching, m_coarse_mapping, m_no_of_coarse_vertices, m_permutation);
+        }
+
+        void setup() override {
+                delete m_coarser;
+                m_coarser = new graph_access();
+        }
+
+        uint64_t run() override {
+                contraction contracter;
+                contracter.contract(m_config, m_G, *m_coarser, m_matching, m_coarse_mapping,
+                                    m_no_of_coarse_vertices, m_permutation);
+                return m_coarser->number_of_nodes() + m_coarser->number_of_edges();
+        }
+
+        uint64_t operations() override { return m_G.number_of_edges(); };
+
+private:
+        graph_access m_G;
+        graph_access* m_coarser;
+        PartitionConfig m_config;
+        Matching m_matching;
+        CoarseMapping m_coarse_mapping;
+        NodePermutationMap m_permutation;
+        NodeID m_no_of_coarse_vertices;
+};
+
+// expansion*^2 ratings of an r-mat graph
+class rating_kernel : public micro_kernel {
+public:
+        std::string name() override { return "edge_ratings::rate"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                graph_generators::generate(m_G, "rmat", scale, seed);
+                configure(m_config, seed);
+        }
+
+        uint64_t run() override {
+                edge_ratings rating(m_config);
+                rating.rate(m_G, 0);
+
+                double sum = 0;
+                forall_edges(m_G, e) {
+                        sum += m_G.getEdgeRating(e);
+                } endfor
+                return (uint64_t) sum;
+        }
+
+        uint64_t operations() override { return m_G.number_of_edges(); };
+
+private:
+        graph_access m_G;
+        PartitionConfig m_config;
+};
+
+// maximum flow through a grid with random capacities, the source is attached to the
+// first column and the sink to the last column (like the corridor of a flow refinement)
+class flow_kernel : public micro_kernel {
+public:
+        std::string name() override { return "push_relabel"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                graph_generators::generate(m_G, "grid2d", scale, seed);
+                m_seed    = seed;
+                m_columns = 1 << ((scale + 1) / 2);
+        }
+
+        void setup() override {
+                NodeID n = m_G.number_of_nodes();
+                m_source = n;
+                m_sink   = n + 1;
+                m_flow_graph.start_construction(n + 2, m_G.number_of_edges() + 2 * n / m_columns);
+                forall_nodes(m_G, node) {
+                        forall_out_edges(m_G, e, node) {
+                                NodeID target = m_G.getEdgeTarget(e);
+                                uint64_t key  = ((uint64_t)std::min(node, target) << 32) | std::max(node, target);
+                                m_flow_graph.new_edge(node, target, 1 + mix(key ^ m_seed) % 10);
+                        } endfor
+
+                        if( node % m_columns == 0 )             m_flow_graph.new_edge(m_source, node, n);
+                        if( node % m_columns == m_columns - 1 ) m_flow_graph.new_edge(node, m_sink, n);
+                } endfor
+                m_flow_graph.finish_construction();
+        }
+
+        uint64_t run() override {
+                push_relabel solver;
+                std::vector< NodeID > source_set;
+                return solver.solve_max_flow_min_cut(m_flow_graph, m_source, m_sink, true, source_set) + source_set.size();
+        }
+
+        uint64_t operations() override { return m_flow_graph.number_of_edges(); };
+
+private:
+        graph_access m_G;
+        flow_graph m_flow_graph;
+        NodeID m_source;
+        NodeID m_sink;
+        NodeID m_columns;
+        unsigned m_seed;
+};
+
+// distances of random pairs of PEs of the hierarchy 4:16:64 (4096 PEs)
+class distance_kernel : public micro_kernel {
+public:
+        distance_kernel() : m_distances(PES, PES) {};
+
+        std::string name() override { return "online_distance_matrix::get_xy"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                PartitionConfig config;
+                config.group_sizes = {4, 16, 64};
+                config.distances   = {1, 10, 100};
+                m_distances.setPartitionConfig(config);
+
+                std::mt19937 rng(seed);
+                m_pairs.resize(4 << scale);
+                for( unsigned i = 0; i < m_pairs.size(); i++) {
+                        m_pairs[i] = std::make_pair(rng() % PES, rng() % PES);
+                }
+        }
+
+        uint64_t run() override {
+                uint64_t checksum = 0;
+                for( unsigned i = 0; i < m_pairs.size(); i++) {
+                        checksum += m_distances.get_xy(m_pairs[i].first, m_pairs[i].second);
+                }
+                return checksum;
+        }
+
+        uint64_t operations() override { return m_pairs.size(); };
+
+private:
+        static const unsigned PES = 4096;
+
+        online_distance_matrix m_distances;
+        std::vector< std::pair< unsigned, unsigned > > m_pairs;
+};
+
+// the label counting of parhip's label propagation: the weights of the labels around
+// every node of an r-mat graph are accumulated and the heaviest label is selected
+class hashmap_kernel : public micro_kernel {
+public:
+        std::string name() override { return "linear_probing_hashmap"; };
+
+        void prepare(unsigned scale, unsigned seed) override {
+                graph_generators::generate(m_G, "rmat", scale, seed);
+
+                std::mt19937 rng(seed);
+                m_labels.resize(m_G.number_of_nodes());
+                for( NodeID node = 0; node < m_labels.size(); node++) {
+                        m_labels[node] = rng() % std::max(1u, m_G.number_of_nodes() / 4);
+                }
+
+                // parhip is compiled with other types, its kernel gets the graph as CSR arrays
+                m_xadj.resize(m_G.number_of_nodes() + 1);
+                m_adjncy.resize(m_G.number_of_edges());
+                m_adjwgt.resize(m_G.number_of_edges());
+                forall_nodes(m_G, node) {
+                        m_xadj[node] = m_G.get_first_edge(node);
+                        forall_out_edges(m_G, e, node) {
+                                m_adjncy[e] = m_G.getEdgeTarget(e);
+                                m_adjwgt[e] = m_G.getEdgeWeight(e);
+                        } endfor
+                } endfor
+                m_xadj[m_G.number_of_nodes()] = m_G.number_of_edges();
+        }
+
+        uint64_t run() override {
+                return parhip_kernels::label_counting(m_xadj, m_adjncy, m_adjwgt, m_labels, m_G.getMaxDegree());
+        }
+
+        uint64_t operations() override { return m_G.number_of_edges(); };
+
+private:
+        graph_access m_G;
+        std::vector< uint64_t > m_xadj;
+        std::vector< uint64_t > m_adjncy;
+        std::vector< uint64_t > m_adjwgt;
+        std::vector< uint64_t > m_labels;
+};
+
+struct kernel_statistics {
+        std::string name;
+        uint64_t operations;
+        unsigned repetitions;
+        double min;
+        double median;
+        double mean;
+        double stddev;
+        double max;
+        bool stable; // all runs gave the same checksum
+};
+
+static kernel_statistics measure(micro_kernel & kernel, unsigned warmup, unsigned repetitions) {
+        uint64_t checksum = 0;
+        for( unsigned i = 0; i < warmup; i++) {
+                kernel.setup();
+                checksum = kernel.run();
+        }
+
+        kernel_statistics stats;
+        stats.name        = kernel.name();
+        stats.repetitions = repetitions;
+        stats.stable      = true;
+
+        std::vector< double > times;
+        for( unsigned i = 0; i < repetitions; i++) {
+                kernel.setup();
+                timer t;
+                uint64_t cur_checksum = kernel.run();
+                times.push_back(t.elapsed());
+
+                if( (warmup > 0 || i > 0) && cur_checksum != checksum ) stats.stable = false;
+                checksum = cur_checksum;
+        }
+        stats.operations = kernel.operations();
+
+        std::sort(times.begin(), times.end());
+        unsigned r   = times.size();
+        stats.min    = times[0];
+        stats.max    = times[r-1];
+        stats.median = r % 2 == 1 ? times[r/2] : (times[r/2 - 1] + times[r/2]) / 2;
+
+        double sum = 0;
+        for( unsigned i = 0; i < r; i++) sum += times[i];
+        stats.mean = sum / r;
+
+        double squares = 0;
+        for( unsigned i = 0; i < r; i++) squares += (times[i] - stats.mean) * (times[i] - stats.mean);
+        stats.stddev = r > 1 ? sqrt(squares / (r - 1)) : 0;
+
+        return stats;
+}
+
+static std::vector< std::string > split(const std::string & str, char delim) {
+        std::vector< std::string > parts;
+        std::stringstream ss(str);
+        std::string part;
+        while( std::getline(ss, part, delim) ) {
+                if( !part.empty() ) parts.push_back(part);
+        }
+        return parts;
+}
+
+// times the hot data structures and kernels of the partitioner on synthetic inputs
+int main(int argn, char **argv) {
+        const char *progname = argv[0];
+
+        struct arg_lit *help        = arg_lit0(NULL, "help", "Print help.");
+        struct arg_int *scale       = arg_int0(NULL, "scale", NULL, "The inputs have roughly 2^scale nodes. Default: 18");
+        struct arg_int *seed        = arg_int0(NULL, "seed", NULL, "Seed of the inputs. Default: 0");
+        struct arg_int *warmup      = arg_int0(NULL, "warmup", NULL, "Untimed runs before the measurement. Default: 2");
+        struct arg_int *repetitions = arg_int0(NULL, "repetitions", NULL, "Timed runs. Default: 10");
+        struct arg_str *kernels     = arg_str0(NULL, "kernels", NULL, "Comma separated kernels. Default: all");
+        struct arg_str *output      = arg_str0(NULL, "output_filename", NULL, "CSV file with the statistics.");
+        struct arg_end *end         = arg_end(100);
+
+        void* argtable[] = { help, scale, seed, warmup, repetitions, kernels, output, end };
+
+        int nerrors = arg_parse(argn, argv, argtable);
+        if( help->count > 0 ) {
+                printf("Usage: %s", progname);
+                arg_print_syntax(stdout, argtable, "\n");
+                arg_print_glossary(stdout, argtable,"  %-40s %s\n");
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 0;
+        }
+
+        if( nerrors > 0 ) {
+                arg_print_errors(stderr, end, progname);
+                printf("Try '%s --help' for more information.\n",progname);
+                arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+                return 1;
+        }
+
+        unsigned input_scale = scale->count       > 0 ? scale->ival[0]       : 18;
+        unsigned input_seed  = seed->count        > 0 ? seed->ival[0]        : 0;
+        unsigned warmup_runs = warmup->count      > 0 ? warmup->ival[0]      : 2;
+        unsigned timed_runs  = repetitions->count > 0 ? repetitions->ival[0] : 10;
+        timed_runs           = std::max(1u, timed_runs);
+
+        std::vector< micro_kernel* > all_kernels;
+        all_kernels.push_back(new queue_kernel(true));
+        all_kernels.push_back(new queue_kernel(false));
+        all_kernels.push_back(new boundary_kernel());
+        all_kernels.push_back(new contraction_kernel());
+        all_kernels.push_back(new rating_kernel());
+        all_kernels.push_back(new flow_kernel());
+        all_kernels.push_back(new distance_kernel());
+        all_kernels.push_back(new hashmap_kernel());
+
+        std::vector< micro_kernel* > selected = all_kernels;
+        if( kernels->count > 0 ) {
+                selected.clear();
+                std::vector< std::string > names = split(kernels->sval[0], ',');
+                for( unsigned i = 0; i < names.size(); i++) {
+                        bool found = false;
+                        for( unsigned j = 0; j < all_kernels.size(); j++) {
+                                if( all_kernels[j]->name() == names[i] ) {
+                                        selected.push_back(all_kernels[j]);
+                                        found = true;
+                                }
+                        }
+                        if( !found ) {
+                                std::cerr <<  "unknown kernel " << names[i]  << std::endl;
+                                return 1;
+                        }
+                }
+        }
+
+        std::ofstream csv;
+        if( output->count > 0 ) {
+                csv.open(output->sval[0]);
+                if( !csv ) {
+                        std::cerr <<  "could not open " << output->sval[0]  << std::endl;
+                        return 1;
+                }
+                csv << "kernel,scale,operations,repetitions,min,median,mean,stddev,max,ns_per_operation" << std::endl;
+        }
+
+        std::cout << std::left << std::setw(32) << "kernel" << std::right
+                  << std::setw(12) << "operations"
+                  << std::setw(12) << "min [s]"
+                  << std::setw(12) << "median [s]"
+                  << std::setw(12) << "mean [s]"
+                  << std::setw(12) << "stddev [s]"
+                  << std::setw(12) << "max [s]"
+                  << std::setw(10) << "ns/op" << std::endl;
+
+        int ret = 0;
+        for( unsigned i = 0; i < selected.size(); i++) {
+                selected[i]->prepare(input_scale, input_seed);
+                kernel_statistics stats = measure(*selected[i], warmup_runs, timed_runs);
+                double ns_per_operation = stats.operations > 0 ? 1e9 * stats.median / stats.operations : 0;
+
+                std::cout << std::left << std::setw(32) << stats.name << std::right << std::fixed
+                          << std::setw(12) << stats.operations << std::setprecision(6)
+                          << std::setw(12) << stats.min
+                          << std::setw(12) << stats.median
+                          << std::setw(12) << stats.mean
+                          << std::setw(12) << stats.stddev
+                          << std::setw(12) << stats.max << std::setprecision(2)
+                          << std::setw(10) << ns_per_operation << std::endl;
+
+                if( !stats.stable ) {
+                        std::cerr <<  "the runs of " << stats.name << " gave different results"  << std::endl;
+                        ret = 1;
+                }
+
+                if( csv ) {
+                        csv << stats.name << "," << input_scale << "," << stats.operations << "," << stats.repetitions
+                            << std::setprecision(9)
+                            << "," << stats.min << "," << stats.median << "," << stats.mean
+                            << "," << stats.stddev << "," << stats.max << "," << ns_per_operation << std::endl;
+                }
+        }
+
+        for( unsigned i = 0; i < all_kernels.size(); i++) {
+                delete all_kernels[i];
+        }
+        arg_freetable(argtable, sizeof(argtable) / sizeof(argtable[0]));
+        return ret;
+}
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * parhip_kernels.cpp
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include "definitions.h"
+#include "data_structure/linear_probing_hashmap.h"
+#include "parhip_kernels.h"
+
+// parhip's default ht_fill_factor (init truncates it to an integer like in parhip)
+static const double HT_FILL_FACTOR = 1.6;
+
+uint64_t parhip_kernels::label_counting( const std::vector< uint64_t > & xadj, 
+                                         const std::vector< uint64_t > & adjncy, 
+                                         const std::vector< uint64_t > & adjwgt, 
+                                         const std::vector< uint64_t > & labels, 
+                                         uint64_t max_degree ) {
+        linear_probing_hashmap hash_map;
+        hash_map.init(std::max< ULONG >(1, max_degree), HT_FILL_FACTOR);
+
+        uint64_t checksum = 0;
+        for( NodeID node = 0; node + 1 < xadj.size(); node++) {
+                for( EdgeID e = xadj[node]; e < xadj[node + 1]; e++) {
+                        hash_map[labels[adjncy[e]]] += adjwgt[e];
+                }
+
+                NodeID max_label = labels[node];
+                NodeID max_value = 0;
+                for( EdgeID e = xadj[node]; e < xadj[node + 1]; e++) {
+                        NodeID label = labels[adjncy[e]];
+                        if( hash_map[label] > max_value ) {
+                                max_value = hash_map[label];
+                                max_label = label;
+                        }
+                }
+                checksum += max_label + max_value;
+                hash_map.clear();
+        }
+        return checksum;
+}
@@ -0,0 +1,28 @@
+/******************************************************************************
+ * parhip_kernels.h
+ * *
+ * Source of KaHIP -- Karlsruhe High Quality Partitioning.
+ * Christian Schulz <christian.schulz.phone@gmail.com>
+ *****************************************************************************/
+
+#ifndef PARHIP_KERNELS_W7N2C4XE
+#define PARHIP_KERNELS_W7N2C4XE
+
+#include <stdint.h>
+#include <vector>
+
+// kernels of parhip for the microbenchmark. they are compiled in their own translation unit with
+// the include paths and definitions of parhip (64 bit ids), the graph is passed as plain CSR arrays
+class parhip_kernels {
+public:
+        // label counting of parhip's label propagation with its linear_probing_hashmap: the weights of
+        // the labels around every node are accumulated and the heaviest label is selected.
+        // returns a checksum of the selected labels and their weights
+        static uint64_t label_counting( const std::vector< uint64_t > & xadj, 
+                                        const std::vector< uint64_t > & adjncy, 
+                                        const std::vector< uint64_t > & adjwgt, 
+                                        const std::vector< uint64_t > & labels, 
+                                        uint64_t max_degree );
+};
+
+#endif /* end of include guard: PARHIP_KERNELS_W7N2C4XE */
@@ -38,5 +38,15 @@ int main(int argn, char **argv) {
         kaffpa(&n, vwgt, xadj, adjcwgt, adjncy, &nparts, &imbalance, false, 0, ECO, & edge_cut, part);
 
         std::cout <<  "edge cut " <<  edge_cut  << std::endl;
+
+        // the same using a handle, the graph is only borrowed and can be partitioned repeatedly
+        kaffpa_handle handle = kaffpa_create(ECO);
+        kaffpa_set_option(handle, "nparts", nparts);
+        kaffpa_set_option(handle, "imbalance", imbalance);
+        kaffpa_set_graph(handle, n, vwgt, xadj, adjcwgt, adjncy);
+        kaffpa_partition(handle, &edge_cut, part);
+        kaffpa_destroy(handle);
+
+        std::cout <<  "edge cut (handle) " <<  edge_cut  << std::endl;
                 
 }
@@ -5,9 +5,17 @@ template<typename T>
 void omp_set_num_threads(T) {}
 
 inline int omp_get_thread_num() {
-        return 1;
+        return 0;
 }
 
 inline int omp_get_max_threads() {
         return 1;
 }
+
+inline int omp_get_num_threads() {
+        return 1;
+}
+
+inline int omp_in_parallel() {
+        return 0;
+}